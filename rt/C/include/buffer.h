@@ -82,6 +82,15 @@ struct buffer {
     unsigned int       ref_cnt;     /**< Reference counter            */
     struct buffer     *prev;        /**< Previous buffer              */
     struct buffer     *next;        /**< Next buffer                  */
+    size_t             line;        /**< 1st char. line (0: unknown)  */
+    size_t             column;      /**< 1st char. column             */
+    int                pos_chained; /**< Position follows prev. buffer */
+    int                nl_counted;  /**< Newlines are counted         */
+    size_t             nl_cnt;      /**< Newline count                */
+    size_t             nl_tail;     /**< Chars. after last newline    */
+    unsigned int       pins;        /**< Newline counting pins        */
+    int                dying;       /**< Buffer is being destroyed    */
+    size_t            *nl_index;    /**< Newline count & offsets      */
 };  /* end of struct buffer */
 
 
@@ -118,19 +127,20 @@ struct buffer {
 /**
  *  \brief  Reference buffer
  *
- *  The macro increments the buffer reference counter.
+ *  The macro increments the buffer reference counter (atomically).
  *
  *  \param  buffer  Buffer
  *
  *  \return Buffer reference counter after the operation
  */
-#define buffer_ref(buffer) (++(buffer)->ref_cnt)
+#define buffer_ref(buffer) \
+    __atomic_add_fetch(&(buffer)->ref_cnt, 1, __ATOMIC_RELAXED)
 
 
 /**
  *  \brief  Unreference buffer
  *
- *  The macro decrements the buffer reference counter.
+ *  The macro decrements the buffer reference counter (atomically).
  *  If the reference count falls to 0, buffer destructor
  *  is called and the argument is set to \c NULL.
  *
@@ -139,7 +149,8 @@ struct buffer {
  *  \return Buffer reference counter after the operation
  */
 #define buffer_unref(buffer) \
-    (--(buffer)->ref_cnt ? : (buffer_destroy(buffer), (buffer) = NULL, 0))
+    (__atomic_sub_fetch(&(buffer)->ref_cnt, 1, __ATOMIC_ACQ_REL) ? : \
+     (buffer_destroy(buffer), (buffer) = NULL, 0))
 
 
 /**
@@ -190,6 +201,47 @@ struct buffer {
 #define buffer_is_last(buffer) ((buffer)->is_last)
 
 
+/**
+ *  \brief  Buffer source position getter
+ *
+ *  Position of the buffer 1st character in line-based source.
+ *  Lines and columns are numbered starting by 1;
+ *  line 0 means that the position is unknown.
+ *
+ *  \param  buffer  Buffer
+ *
+ *  \return Buffer 1st character line number
+ */
+#define buffer_line(buffer) ((buffer)->line)
+
+
+/**
+ *  \brief  Buffer source position setter
+ *
+ *  \param  buffer  Buffer
+ *  \param  l       Line   of the buffer 1st character
+ *  \param  c       Column of the buffer 1st character
+ */
+#define buffer_set_position(buffer, l, c) \
+    ((buffer)->line = (l), (buffer)->column = (c))
+
+
+/**
+ *  \brief  Chain buffer source position
+ *
+ *  The buffer 1st character position shall be the one just after
+ *  the previous buffer in sequence (or 1:1 if there's none).
+ *  The position is only resolved when required (by \ref buffer_position
+ *  or \ref buffer_end_position); should the previous buffer be destroyed
+ *  before that, the position is handed over, then (the previous buffer
+ *  newlines are counted by the destructor).
+ *  Newlines are never counted while holding the buffer sequence lock.
+ *
+ *  \param  buffer  Buffer
+ */
+#define buffer_chain_position(buffer) ((buffer)->pos_chained = 1)
+
+
 /**
  *  \brief  Buffer constructor
  *
@@ -220,4 +272,42 @@ buffer_t *buffer_create(char *data, size_t size, buffer_cleanup_fn *cleanup_fn,
  */
 void buffer_destroy(buffer_t *buffer);
 
+
+/**
+ *  \brief  Resolve source position of buffer data offset
+ *
+ *  The function computes line and column of character
+ *  at the \c offset in the buffer data (\c offset may also
+ *  be equal to the buffer size; the position just after the
+ *  buffer data is computed, then).
+ *  The buffer position must be known or chained
+ *  (see \ref buffer_set_position and \ref buffer_chain_position).
+ *
+ *  The function uses the buffer newline index; the index is built
+ *  upon the first call.
+ *  Should the index allocation fail, newlines are counted directly.
+ *  The function may be called by multiple threads concurrently.
+ *
+ *  \param  buffer  Buffer
+ *  \param  offset  Offset in the buffer data
+ *  \param  line    Line   number (output)
+ *  \param  column  Column number (output)
+ */
+void buffer_position(buffer_t *buffer, size_t offset, size_t *line, size_t *column);
+
+
+/**
+ *  \brief  Resolve source position just after buffer data
+ *
+ *  Unlike \ref buffer_position, the function doesn't build the buffer
+ *  newline index; it only counts the newlines.
+ *  The buffer position must be known or chained
+ *  (see \ref buffer_set_position and \ref buffer_chain_position).
+ *
+ *  \param  buffer  Buffer
+ *  \param  line    Line   number (output)
+ *  \param  column  Column number (output)
+ */
+void buffer_end_position(buffer_t *buffer, size_t *line, size_t *column);
+
 #endif /* end of #ifndef CTXFryer__buffer_h */
@@ -32,19 +32,98 @@
 #include <unistd.h>
 
 
-typedef struct fsa        fsa_t;         /**< FSA                             */
-typedef struct fsa_state  fsa_state_t;   /**< FSA state                       */
-typedef struct fsa_branch fsa_branch_t;  /**< FSA branch                      */
-typedef uint32_t          fsa_id_t;      /**< FSA ID type                     */
-typedef unsigned int      fsa_accept_t;  /**< FSA accepted language code type */
+typedef struct fsa            fsa_t;             /**< FSA                             */
+typedef struct fsa_state      fsa_state_t;       /**< FSA state                       */
+typedef struct fsa_branch     fsa_branch_t;      /**< FSA branch                      */
+typedef struct fsa_comb       fsa_comb_t;        /**< FSA comb-vector transitions     */
+typedef struct fsa_comb_entry fsa_comb_entry_t;  /**< FSA comb-vector entry           */
+typedef struct fsa_loop       fsa_loop_t;        /**< FSA state self-loop             */
+typedef uint32_t              fsa_id_t;          /**< FSA ID type                     */
+typedef unsigned int          fsa_accept_t;      /**< FSA accepted language code type */
 
 
-/** FSA */
+/**
+ *  \brief  Dense transition row size
+ *
+ *  The rows are indexed by input characters (as unsigned bytes).
+ */
+#define FSA_TRANS_ROW_SIZE 256
+
+
+/**
+ *  \brief  Direct-coded FSA scanner prototype
+ *
+ *  The scanner follows transitions from the \c state by characters
+ *  of the \c data beginning at the \c offset.
+ *  It stops (and returns the current state) when an accepting
+ *  or dead end state is reached or when the data end is reached.
+ *  If no transition matches the next character, it stops
+ *  and returns \c NULL.
+ *  In all cases, the \c offset is set just after the last character
+ *  used.
+ *  The scanning may therefore be resumed by another call.
+ *
+ *  \param  state   FSA state (with branches)
+ *  \param  data    Input data
+ *  \param  size    Input data size
+ *  \param  offset  Input data offset (in/out)
+ *
+ *  \return FSA state or \c NULL if no transition matched
+ */
+typedef const fsa_state_t *fsa_scan_fn(
+    const fsa_state_t *state,
+    const char        *data,
+    size_t             size,
+    size_t            *offset);
+
+
+/**
+ *  \brief  FSA
+ *
+ *  The FSA may optionally provide comb-vector compressed transitions
+ *  of all its states; if so, they're used instead of the states'
+ *  own transition definitions.
+ *  Alternatively, the FSA may provide direct-coded scanner;
+ *  if so, it's used for scanning instead of any transition tables.
+ *
+ *  Skipped languages (e.g. white spaces or comments) are ignorable;
+ *  the lexical analyser discards their words silently.
+ */
 struct fsa {
-    const fsa_id_t     id;    /**< ID         */
-    const fsa_state_t *root;  /**< Root state */
+    const fsa_id_t             id;        /**< ID                                */
+    const fsa_state_t         *root;      /**< Root state                        */
+    const fsa_comb_t          *comb;      /**< Comb-vector transitions (or NULL) */
+    fsa_scan_fn               *scan;      /**< Direct-coded scanner (or NULL)    */
+    const size_t               skip_cnt;  /**< Skipped language code count       */
+    const fsa_accept_t * const skips;     /**< Skipped language codes (or NULL)  */
 };  /* end of struct fsa */
 
+/** FSA comb-vector entry */
+struct fsa_comb_entry {
+    const fsa_state_t *check;   /**< Owner state  */
+    const fsa_state_t *target;  /**< Target state */
+};  /* end of struct fsa_comb_entry */
+
+/**
+ *  \brief  FSA comb-vector compressed transitions
+ *
+ *  Input characters are mapped to equivalence classes first
+ *  (characters of a class have the same transitions in all states;
+ *  class 0 has no transitions at all; there are at most 256 classes).
+ *  Rows of the state x class transition table are then overlaid
+ *  in a single vector; each state has its own row displacement.
+ *  Entry at the state displacement + class index is the transition
+ *  target iff its check matches the state.
+ *  Indices beyond the entry count (namely, any if there are no entries
+ *  at all) mean no transition.
+ */
+struct fsa_comb {
+    const unsigned char     class_map[FSA_TRANS_ROW_SIZE];  /**< Char. classes */
+    const size_t            class_cnt;                      /**< Class count   */
+    const size_t            entry_cnt;                      /**< Entry count   */
+    const fsa_comb_entry_t *entries;                        /**< Entries       */
+};  /* end of struct fsa_comb */
+
 /** FSA branch */
 struct fsa_branch {
     const fsa_id_t     id;              /**< ID                       */
@@ -53,13 +132,36 @@ struct fsa_branch {
     const char         intervals[][2];  /**< Character intervals      */
 };  /* end of struct fsa_branch */
 
-/** FSA state */
+/**
+ *  \brief  FSA state self-loop
+ *
+ *  Characters (as unsigned bytes) of the state branch that targets
+ *  the state itself.
+ *  Runs of such characters may be skipped at once (using SIMD).
+ */
+struct fsa_loop {
+    const size_t        interval_cnt;    /**< Character interval count */
+    const unsigned char intervals[][2];  /**< Character intervals      */
+};  /* end of struct fsa_loop */
+
+/**
+ *  \brief  FSA state
+ *
+ *  Transitions are always defined by the branches' character intervals.
+ *  Optionally, the state may also provide a dense transition row,
+ *  i.e. table of target states indexed by (unsigned) input character.
+ *  \c NULL entries in the row mean that there's no matching branch.
+ *  If the row is provided, it's used instead of the intervals.
+ */
 struct fsa_state {
-    const fsa_id_t      id;          /**< ID                           */
-    const size_t        accept_cnt;  /**< Accepted language code count */
-    const fsa_accept_t *accepts;     /**< Accepted language codes      */
-    const size_t        branch_cnt;  /**< Branch count                 */
-    const fsa_branch_t *branches[];  /**< Branches                     */
+    const fsa_id_t             id;          /**< ID                           */
+    const size_t               accept_cnt;  /**< Accepted language code count */
+    const fsa_accept_t        *accepts;     /**< Accepted language codes      */
+    const fsa_state_t * const *trans;       /**< Dense transitions (or NULL)  */
+    const size_t               comb_base;   /**< Comb-vector row displacement */
+    const fsa_loop_t          *self_loop;   /**< Self-loop (or NULL)          */
+    const size_t               branch_cnt;  /**< Branch count                 */
+    const fsa_branch_t        *branches[];  /**< Branches                     */
 };  /* end of struct fsa_state */
 
 
@@ -72,4 +174,89 @@ struct fsa_state {
  */
 #define fsa_root(fsa) ((fsa)->root)
 
+
+/**
+ *  \brief  FSA state dense transition row getter
+ *
+ *  \param  state  FSA state
+ *
+ *  \return The state dense transition row or \c NULL if not available
+ */
+#define fsa_state_trans(state) ((state)->trans)
+
+
+/**
+ *  \brief  FSA comb-vector transitions getter
+ *
+ *  \param  fsa  FSA
+ *
+ *  \return The FSA comb-vector transitions or \c NULL if not available
+ */
+#define fsa_comb(fsa) ((fsa)->comb)
+
+
+/**
+ *  \brief  FSA state self-loop getter
+ *
+ *  \param  state  FSA state
+ *
+ *  \return The state self-loop or \c NULL if not available
+ */
+#define fsa_state_self_loop(state) ((state)->self_loop)
+
+
+/**
+ *  \brief  FSA direct-coded scanner getter
+ *
+ *  \param  fsa  FSA
+ *
+ *  \return The FSA direct-coded scanner or \c NULL if not available
+ */
+#define fsa_scan(fsa) ((fsa)->scan)
+
+
+/**
+ *  \brief  FSA skipped language codes count getter
+ *
+ *  \param  fsa  FSA
+ *
+ *  \return Count of the FSA skipped language codes
+ */
+#define fsa_skip_cnt(fsa) ((fsa)->skip_cnt)
+
+
+/**
+ *  \brief  FSA skipped language codes getter
+ *
+ *  \param  fsa  FSA
+ *
+ *  \return The FSA skipped language codes or \c NULL if there's none
+ */
+#define fsa_skips(fsa) ((fsa)->skips)
+
+
+/**
+ *  \brief  FSA with another set of skipped languages
+ *
+ *  The macro produces FSA (compound literal) sharing the \c fsa
+ *  states and transitions, but skipping the specified languages.
+ *  Since the FSA members are constant, use it as an initialiser.
+ *
+ *  \param  fsa    FSA
+ *  \param  cnt    Skipped language code count
+ *  \param  codes  Skipped language codes (or \c NULL)
+ *
+ *  \return FSA
+ */
+#define fsa_with_skips(fsa, cnt, codes) \
+    ((fsa_t){ \
+        .id       = (fsa)->id, \
+        .root     = (fsa)->root, \
+        .comb     = (fsa)->comb, \
+        .scan     = (fsa)->scan, \
+        .skip_cnt = (cnt), \
+        .skips    = (codes), \
+    })
+
+
 #endif /* end of #ifndef CTXFryer__fsa_h */
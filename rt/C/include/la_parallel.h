@@ -0,0 +1,117 @@
+#ifndef CTXFryer__la_parallel_h
+#define CTXFryer__la_parallel_h
+
+/**
+ *  \brief  Parallel lexical analysis
+ *
+ *  Contiguous source (typically a memory-mapped file) is split
+ *  into chunks which are tokenized concurrently.
+ *  Each chunk (but the 1st one) is lexed speculatively, as if
+ *  a token began at the chunk start.
+ *
+ *  The speculative token streams are then stitched together:
+ *  the true token stream is re-lexed from the end of the previous
+ *  chunk tokens until it hits a token start of the speculative
+ *  stream.
+ *  Since the lexical analysis is deterministic, the streams
+ *  converge there; the rest of the speculative stream is used.
+ *  Typically, convergence takes just a few tokens.
+ *
+ *  The resulting token stream is the same as if the source was
+ *  tokenized sequentially by \ref la_tokenize_batch.
+ *  Skipped lexical items (see \ref fsa_skips) are discarded, too.
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fsa.h"
+#include "lexical_analyser.h"
+
+#include <unistd.h>
+
+
+/**
+ *  \brief  Token stream
+ *
+ *  Tokens are stored in struct-of-arrays form (like in \ref la_batch_t);
+ *  unlike the batch, the arrays are allocated (and grown) by the module.
+ *  Token offsets are absolute (from the source begin).
+ */
+struct la_tokens {
+    size_t  capacity;  /**< Arrays capacity */
+    size_t  cnt;       /**< Tokens count    */
+    int    *codes;     /**< Item codes      */
+    size_t *offsets;   /**< Token offsets   */
+    size_t *lengths;   /**< Token lengths   */
+};  /* end of struct la_tokens */
+
+typedef struct la_tokens la_tokens_t;  /**< Token stream */
+
+
+/**
+ *  \brief  Token stream constructor
+ *
+ *  \param  tokens  Token stream (uninitialised object memory)
+ *
+ *  \return Token stream (empty)
+ */
+la_tokens_t *la_tokens_create(la_tokens_t *tokens);
+
+
+/**
+ *  \brief  Token stream destructor
+ *
+ *  \param  tokens  Token stream
+ */
+void la_tokens_destroy(la_tokens_t *tokens);
+
+
+/**
+ *  \brief  Tokenize source in parallel
+ *
+ *  The source is split into (at most) \c thread_cnt chunks
+ *  of (roughly) the same size, each of them lexed by a thread.
+ *  Tokens are appended to the token stream; as in case of
+ *  \ref la_tokenize_batch, the longest item is chosen and EoF
+ *  is reported as a trailing \ref LEXIG_EOF token.
+ *
+ *  The source must be complete and must stay valid during the call.
+ *
+ *  \param  fsa          Lexical items language FSA
+ *  \param  items_total  Lexical items set cardinality (including EoF item)
+ *  \param  data         Source
+ *  \param  size         Source size
+ *  \param  thread_cnt   Number of threads (1 means sequential tokenization)
+ *  \param  tokens       Token stream
+ *
+ *  \retval LA_OK            if the source was tokenized (up to EoF)
+ *  \retval LA_INPUT_INVALID if unexpected sequence was found in the source
+ *                           (the preceding tokens are in the stream)
+ *  \retval LA_ERROR         on memory allocation failure
+ */
+la_status_t la_tokenize_parallel(const fsa_t *fsa, size_t items_total,
+                                 const char *data, size_t size, size_t thread_cnt,
+                                 la_tokens_t *tokens);
+
+#endif /* end of #ifndef CTXFryer__la_parallel_h */
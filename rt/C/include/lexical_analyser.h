@@ -72,6 +72,14 @@
 #define LEXIG_INVALID (-1)  /**< Invalidated general lexical item code */
 #define LEXIG_EOF       0   /**< End-Of-File general lexical item code */
 
+/**
+ *  \brief  Max. length of lexical item token stored inline
+ *
+ *  The inline token overlays the item buffer offset and next item
+ *  checkpoint (see \ref la_item), so it doesn't enlarge the item.
+ */
+#define LA_ITEM_INLINE_SIZE (2 * sizeof(size_t) + sizeof(buffer_t *))
+
 
 /** Lexical analyser status codes */
 typedef enum {
@@ -82,7 +90,44 @@ typedef enum {
 } la_status_t;  /* end of typedef enum */
 
 
-/** Lexical item description */
+/**
+ *  \brief  Lexical analyser source position tracking modes
+ *
+ *  By default, the analyser tracks line and column of each consumed
+ *  character.
+ *  Alternatively, it may only track byte offsets; lexical item
+ *  lines and columns are then resolved on demand using the buffers
+ *  newline indices (see \ref la_item_token_line).
+ */
+typedef enum {
+    LA_POS_LINE_COLUMN = 0,  /**< Track lines and columns (default) */
+    LA_POS_OFFSET,           /**< Track offsets only                */
+} la_pos_mode_t;  /* end of typedef enum */
+
+
+/**
+ *  \brief  Lexical item description
+ *
+ *  Note that in \ref LA_POS_OFFSET mode, line and column members
+ *  are 0 (unknown) unless resolved by \ref la_item_resolve_position.
+ *  Use the \ref la_item_token_line and \ref la_item_token_column
+ *  accessors to get them.
+ *
+ *  The next item members are the last-accept checkpoint of the item;
+ *  when the item is read, the analyser resumes there (instead of
+ *  walking back over the overrun characters).
+ *  Overrun characters of failed scans aren't scanned again in the same
+ *  FSA states, either (see \ref la_memo).
+ *  They're only valid in the analyser item list.
+ *
+ *  Short fragmented tokens are stored inline when defragmented
+ *  (see \ref la_item_token); the item then holds no buffer
+ *  (the 1st buffer is \c NULL).
+ *  The inline token shares storage with the 1st character offset
+ *  and the next item checkpoint; neither is used once the token
+ *  is inlined (the item is a copy out of the analyser item list
+ *  and its position has been resolved).
+ */
 struct la_item {
     int       code;         /**< Item code                                          */
     size_t    offset;       /**< Item offset in the input                           */
@@ -92,12 +137,58 @@ struct la_item {
     size_t    next_line;    /**< Next item line   number (starting by 1)            */
     size_t    next_column;  /**< Next item column number (starting by 1)            */
     buffer_t *buff_1st;     /**< Buffer holding the 1st character of the item token */
-    size_t    buff_off;     /**< Offset of the 1st character in the above buffer    */
+
+    union {
+        struct {
+            size_t    buff_off;   /**< Offset of the 1st character in the above buffer  */
+            buffer_t *next_buff;  /**< Buffer holding the next item 1st character       */
+            size_t    next_off;   /**< Offset of the next item 1st character in above   */
+        };
+        char token[LA_ITEM_INLINE_SIZE];  /**< Inline token (if 1st buffer is NULL)     */
+    };
 };  /* end of struct la_item */
 
 typedef struct la_item la_item_t;  /**< Lexical item description */
 
 
+/**
+ *  \brief  Resolve lexical item token position
+ *
+ *  The function computes the item token line and column
+ *  (using the item token 1st buffer newline index)
+ *  and stores them in the item.
+ *  It's only necessary in \ref LA_POS_OFFSET mode;
+ *  if the position is already known, the function does nothing.
+ *
+ *  \param  item  Lexical item
+ */
+void la_item_resolve_position(la_item_t *item);
+
+
+/**
+ *  \brief  Compute lexical item token line (lazily)
+ *
+ *  Used by \ref la_item_token_line if the item line isn't known.
+ *
+ *  \param  item  Lexical item
+ *
+ *  \return Line number
+ */
+size_t la_item_lazy_line(const la_item_t *item);
+
+
+/**
+ *  \brief  Compute lexical item token column (lazily)
+ *
+ *  Used by \ref la_item_token_column if the item line isn't known.
+ *
+ *  \param  item  Lexical item
+ *
+ *  \return Column number
+ */
+size_t la_item_lazy_column(const la_item_t *item);
+
+
 /*
  * Lexical item attribute accessors
  */
@@ -153,7 +244,7 @@ typedef struct la_item la_item_t;  /**< Lexical item description */
  *
  *  \return Line number
  */
-#define la_item_token_line(item) ((item)->line)
+#define la_item_token_line(item) ((item)->line ? : la_item_lazy_line(item))
 
 
 /**
@@ -171,9 +262,62 @@ typedef struct la_item la_item_t;  /**< Lexical item description */
  *
  *  \return Column number
  */
-#define la_item_token_column(item) ((item)->column)
+#define la_item_token_column(item) ((item)->line ? (item)->column : la_item_lazy_column(item))
+
+
+/**
+ *  \brief  Lexical items batch
+ *
+ *  Tokens of the batch are stored in struct-of-arrays form;
+ *  the arrays are provided by user.
+ *  Line and column arrays are optional (may be \c NULL).
+ *
+ *  See \ref la_tokenize_batch.
+ */
+struct la_batch {
+    size_t  capacity;  /**< Arrays capacity                    */
+    size_t  cnt;       /**< Tokens count                       */
+    int    *codes;     /**< Item codes                         */
+    size_t *offsets;   /**< Token offsets                      */
+    size_t *lengths;   /**< Token lengths                      */
+    size_t *lines;     /**< Token line numbers   (or \c NULL)  */
+    size_t *columns;   /**< Token column numbers (or \c NULL)  */
+};  /* end of struct la_batch */
+
+typedef struct la_batch la_batch_t;  /**< Lexical items batch */
 
 
+/** Failed scan memo entry */
+struct la_memo_entry {
+    const fsa_state_t *state;     /**< FSA state (NULL means empty slot) */
+    size_t             position;  /**< Input position                    */
+};  /* end of struct la_memo_entry */
+
+typedef struct la_memo_entry la_memo_entry_t;  /**< Failed scan memo entry */
+
+
+/**
+ *  \brief  Failed scans memo
+ *
+ *  When a scan fails (i.e. no branch matches the next character,
+ *  or the input ends), the FSA state and input position pairs visited
+ *  after its last accept are known to lead to no further accept.
+ *  They're kept in the memo (hash set) so that scans of the subsequent
+ *  items stop as soon as they reach such a pair; the overrun characters
+ *  are therefore never re-scanned in the same state again and the
+ *  analysis time is linear in the input size (given that the longest
+ *  items are read).
+ *  Only positions below the memo end may be listed; the memo is emptied
+ *  when the analysis gets past it.
+ */
+struct la_memo {
+    la_memo_entry_t *entries;   /**< Entries (hash table)   */
+    size_t           capacity;  /**< Hash table capacity    */
+    size_t           cnt;       /**< Entry count            */
+    size_t           end;       /**< Memoised positions end */
+};  /* end of struct la_memo */
+
+typedef struct la_memo  la_memo_t;   /**< Failed scans memo      */
 typedef struct la_state la_state_t;  /**< Lexical analyser state */
 typedef struct lexa     lexa_t;      /**< Lexical analyser       */
 
@@ -184,7 +328,7 @@ struct la_state {
     int                seg_int;         /**< Segmentation interrupt flag           */
     la_item_t         *item_list;       /**< Item list                             */
     size_t             item_cnt;        /**< Item list length                      */
-    size_t            *item_pos;        /**< Positions of items in list            */
+    size_t            *item_pos;        /**< Positions of items in list (sparse)   */
     size_t             token_offset;    /**< Current offset of the input head      */
     size_t             token_length;    /**< Current length of the input head      */
     size_t             token_line;      /**< Line   number of head (starting by 1) */
@@ -194,17 +338,21 @@ struct la_state {
     size_t             line;            /**< Current line   number (starting by 1) */
     size_t             column;          /**< Current column number (starting by 1) */
     size_t             buffer_offset;   /**< Offset in the current buffer          */
+    const fsa_state_t *accept_state;    /**< FSA state of the last accept          */
+    la_memo_t          memo;            /**< Failed scans memo                     */
+    size_t             steps;           /**< FSA transitions taken (statistics)    */
 };  /* end of struct la_state */
 
 
 /** Lexical analyser */
 struct lexa {
-    const fsa_t *fsa;          /**< Item lang. FSA       */
-    buffer_t    *buffer;       /**< Current buffer       */
-    buffer_t    *buff_last;    /**< Last buffer in seq.  */
-    la_state_t   state;        /**< Current state        */
-    size_t       items_total;  /**< Item set cardinality */
-    la_status_t  status;       /**< Current status       */
+    const fsa_t   *fsa;          /**< Item lang. FSA         */
+    buffer_t      *buffer;       /**< Current buffer         */
+    buffer_t      *buff_last;    /**< Last buffer in seq.    */
+    la_state_t     state;        /**< Current state          */
+    size_t         items_total;  /**< Item set cardinality   */
+    la_pos_mode_t  pos_mode;     /**< Position tracking mode */
+    la_status_t    status;       /**< Current status         */
 };  /* end of struct lexa */
 
 
@@ -222,6 +370,19 @@ struct lexa {
 #define la_status(la) ((la)->status)
 
 
+/**
+ *  \brief  Count of FSA transitions taken by lexical analyser
+ *
+ *  The statistics counts all the transitions (including those
+ *  taken while memoising failed scans, see \ref la_memo).
+ *
+ *  \param  la  Lexical analyser
+ *
+ *  \return FSA transitions count
+ */
+#define la_steps(la) ((la)->state.steps)
+
+
 /**
  *  \brief  Lexical analyser constructor
  *
@@ -234,6 +395,17 @@ struct lexa {
 lexa_t *la_create(lexa_t *la, const fsa_t *fsa, size_t items_total);
 
 
+/**
+ *  \brief  Set source position tracking mode
+ *
+ *  The mode must be set before any source buffer is added.
+ *
+ *  \param  la    Lexical analyser
+ *  \param  mode  Position tracking mode
+ */
+void la_set_pos_mode(lexa_t *la, la_pos_mode_t mode);
+
+
 /**
  *  \brief  Lexical analyser destructor
  *
@@ -314,6 +486,10 @@ void la_add_buffer(lexa_t *la, buffer_t *buffer);
  *  end of file), the function provides the \ref LEXIG_EOF as
  *  a single item.
  *
+ *  Items of languages skipped by the FSA (see \ref fsa_skips) are
+ *  never provided; if such an item is the longest one on the input
+ *  head, it's read silently and the segmentation continues.
+ *
  *  An item is supposed to be copied by user using \ref la_item_copy.
  *  This is necessary to obtain the item token (since it may require
  *  data copying).
@@ -382,6 +558,44 @@ const la_item_t *la_get_item(lexa_t *la, int item_code);
 la_status_t la_read_item(lexa_t *la, int item_code);
 
 
+/**
+ *  \brief  Tokenize input in batch
+ *
+ *  The function segments all the available input and appends
+ *  tokens to the batch until the batch is full or end of file
+ *  is reached.
+ *  The longest lexical item is always chosen (if more of them
+ *  are of the same length, the 1st one in the item list is chosen)
+ *  and read.
+ *  Reaching end of file is reported by \ref LEXIG_EOF token
+ *  (of zero length) appended as the last one.
+ *
+ *  If the input is exhausted, the tokens found so far are kept
+ *  in the batch; the function may be called again after another
+ *  source buffer is added to resume the tokenization (and append
+ *  further tokens).
+ *  The user resets the batch tokens count after consuming them.
+ *
+ *  Tokens are recognised by running the FSA directly on the current
+ *  buffer data (no item lists are built); the general segmentation
+ *  is only used if the longest token is ambiguous (accepted by more
+ *  languages), if it may continue in the next buffer, if the scan
+ *  overruns it or if a failed scans overrun lies ahead (see \ref la_memo).
+ *
+ *  Note that in \ref LA_POS_OFFSET mode, lines and columns
+ *  (if required) are resolved using the buffers newline indices.
+ *
+ *  \param  la     Lexical analyser
+ *  \param  batch  Lexical items batch
+ *
+ *  \retval LA_OK              if the batch is full or end of file was reached
+ *  \retval LA_INPUT_EXHAUSTED if input is exhausted
+ *  \retval LA_INPUT_INVALID   if no valid lexical item is recognised
+ *  \retval LA_ERROR           in case of an error
+ */
+la_status_t la_tokenize_batch(lexa_t *la, la_batch_t *batch);
+
+
 /**
  *  \brief  Get lexical item token
  *
@@ -401,6 +615,8 @@ la_status_t la_read_item(lexa_t *la, int item_code);
  *  in this case, the previously used buffers are unreferenced
  *  and the new one is cached for future calls of the function
  *  (so that the copying is amortised).
+ *  Tokens of up to \ref LA_ITEM_INLINE_SIZE octets are concatenated
+ *  in the item itself, instead (no allocation takes place).
  *
  *  Note that the above means that the function always returns
  *  the same value and also, the value stays valid as long as
@@ -434,7 +650,8 @@ const char *la_item_token(la_item_t *item, size_t *length);
  *  \ref la_read_item (if it's necessary to store it
  *  and/or take its token).
  *
- *  Note that the function doesn't copy any data;
+ *  Note that the function doesn't copy any data
+ *  (except of inline token);
  *  it only initialises the destination argument
  *  by the source and reference the item buffer(s).
  *  The overhead is therefore quite negligable.
@@ -57,6 +57,7 @@ struct objpool {
     void   *cache;      /**< Objects cache              */
     size_t  cache_cnt;  /**< Cached objects count       */
     size_t  cache_max;  /**< Cached objects max. count  */
+    size_t  align;      /**< Object alignment (0: any)  */
 };  /* end of struct objpool */
 
 typedef struct objpool objpool_t;  /**< Object pool */
@@ -74,6 +75,7 @@ typedef struct objpool objpool_t;  /**< Object pool */
     NULL, \
     0, \
     (cache_max), \
+    0, \
 }
 
 
@@ -87,6 +89,16 @@ typedef struct objpool objpool_t;  /**< Object pool */
 #define objpool_size(pool) ((pool)->size)
 
 
+/**
+ *  \brief  Object alignment
+ *
+ *  \param  pool  Object pool
+ *
+ *  \return Pooled object alignment (0 means default)
+ */
+#define objpool_align(pool) ((pool)->align)
+
+
 /**
  *  \brief  Cache max. capacity
  *
@@ -144,6 +156,24 @@ typedef struct objpool objpool_t;  /**< Object pool */
 void objpool_init(objpool_t *pool, size_t size, size_t cache_max, size_t prealloc_cnt);
 
 
+/**
+ *  \brief  Initialise object pool of aligned objects
+ *
+ *  Same as \ref objpool_init, but object memory is aligned
+ *  (see \c posix_memalign).
+ *  That may be required e.g. for direct I/O data blocks.
+ *
+ *  \param  pool          Object pool memory (uninitialised)
+ *  \param  size          Object size
+ *  \param  align         Object alignment (power of 2 multiple of
+ *                        pointer size or 0 for default alignment)
+ *  \param  cache_max     Max. amount of cached objects
+ *  \param  prealloc_cnt  Amount of pre-allocated objects
+ *                        (passed to \ref objpool_prealloc)
+ */
+void objpool_init_aligned(objpool_t *pool, size_t size, size_t align, size_t cache_max, size_t prealloc_cnt);
+
+
 /**
  *  \brief  Allocate an object from the pool
  *
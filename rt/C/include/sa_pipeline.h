@@ -0,0 +1,178 @@
+#ifndef CTXFryer__sa_pipeline_h
+#define CTXFryer__sa_pipeline_h
+
+/**
+ *  \brief  Pipelined syntax analysis
+ *
+ *  Reading of the source, its lexical analysis and parsing are
+ *  done by 3 stages running concurrently:
+ *  1/ the reader thread obtains source buffers (e.g. from a source file)
+ *  2/ the lexer thread segments the buffers into lexical items
+ *     and passes them on in batches
+ *  3/ the parser (the caller thread) shifts the lexical items
+ *
+ *  The stages are connected by bounded single-producer/single-consumer
+ *  queues (see \ref spsc_queue_t); lexical item batches are recycled
+ *  (returned to the lexer by another queue).
+ *  Source buffers are passed between the threads; that's safe since
+ *  buffer reference counting is atomic.
+ *  Note that the source buffers cleanup must be thread-safe, too
+ *  (which is the case for \ref srcfile_t and \ref srcdecomp_t buffers).
+ *
+ *  The lexer runs ahead of the parser as long as the lexical items
+ *  are unambiguous.
+ *  If there are more alternatives (e.g. tokens of different length),
+ *  the choice depends on the parser state; the lexer passes the batch
+ *  ending by the alternatives (see \ref sa_set_items) and waits
+ *  for the parser to report the shifted item (by another queue).
+ *  Positions of the lexical items are resolved by the lexer stage
+ *  (the buffers newline indices aren't shared).
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "buffer.h"
+#include "lexical_analyser.h"
+#include "syntax_analyser.h"
+#include "spsc_queue.h"
+
+#include <unistd.h>
+#include <pthread.h>
+
+
+#define SA_PIPELINE_BUFFERS 8  /**< Source buffers queue capacity    */
+#define SA_PIPELINE_BATCHES 4  /**< Amount of lexical items batches  */
+
+
+/**
+ *  \brief  Source buffers provider prototype
+ *
+ *  The function has the same semantics as \ref srcfile_next_buffer
+ *  (or \ref srcdecomp_next_buffer); it's called by the reader thread.
+ *
+ *  \param[in]   source  Source object
+ *  \param[out]  buffer  Source buffer
+ *  \param[out]  last    Last bit flag
+ *
+ *  \retval 0       on success
+ *  \retval ENODATA if no more data may be read
+ *  \retval errno   on error
+ */
+typedef int sa_pipeline_source_fn(void *source, buffer_t **buffer, int *last);
+
+
+typedef struct sa_pipeline       sa_pipeline_t;        /**< Syntax analysis pipeline */
+typedef struct sa_pipeline_batch sa_pipeline_batch_t;  /**< Lexical items batch      */
+
+
+/** Lexical items batch */
+struct sa_pipeline_batch {
+    size_t     cnt;        /**< Items count                        */
+    la_item_t *items;      /**< Items (copies, owned)              */
+    int        ambiguous;  /**< Batch ends by item alternatives    */
+};  /* end of struct sa_pipeline_batch */
+
+
+/** Syntax analysis pipeline */
+struct sa_pipeline {
+    syxa_t                *sa;           /**< Syntax analyser                      */
+    sa_pipeline_source_fn *source_fn;    /**< Source buffers provider              */
+    void                  *source;       /**< Source object                        */
+    size_t                 batch_size;   /**< Lexical items batch capacity         */
+    sa_pipeline_batch_t   *batches;      /**< Lexical items batches                */
+    spsc_queue_t           buffers;      /**< Reader to lexer queue (buffers)      */
+    spsc_queue_t           full;         /**< Lexer to parser queue (batches)      */
+    spsc_queue_t           empty;        /**< Parser to lexer queue (batches)      */
+    spsc_queue_t           choices;      /**< Parser to lexer queue (item choices) */
+    pthread_t              reader;       /**< Reader thread                        */
+    pthread_t              lexer;        /**< Lexer thread                         */
+    int                    source_erno;  /**< Source error (0 if none)             */
+    la_status_t            la_status;    /**< Lexer stage status                   */
+};  /* end of struct sa_pipeline */
+
+
+/**
+ *  \brief  Source error getter
+ *
+ *  If the parsing failed with \c SA_ERROR, the source may have failed.
+ *
+ *  \param  pipe  Pipeline
+ *
+ *  \return Source error code (0 if there was no error)
+ */
+#define sa_pipeline_source_error(pipe) ((pipe)->source_erno)
+
+
+/**
+ *  \brief  Pipeline constructor
+ *
+ *  The syntax analyser must be created; no source may be added to it.
+ *  Its lexical analyser is used by the lexer stage.
+ *
+ *  \param  pipe        Pipeline (uninitialised object memory)
+ *  \param  sa          Syntax analyser
+ *  \param  source_fn   Source buffers provider
+ *  \param  source      Source object (\c source_fn 1st argument)
+ *  \param  batch_size  Lexical items batch capacity
+ *                      (not counting trailing alternatives)
+ *
+ *  \return Pipeline or \c NULL in case of memory error
+ */
+sa_pipeline_t *sa_pipeline_create(sa_pipeline_t         *pipe,
+                                  syxa_t                *sa,
+                                  sa_pipeline_source_fn *source_fn,
+                                  void                  *source,
+                                  size_t                 batch_size);
+
+
+/**
+ *  \brief  Pipeline destructor
+ *
+ *  \param  pipe  Pipeline
+ */
+void sa_pipeline_destroy(sa_pipeline_t *pipe);
+
+
+/**
+ *  \brief  Parse source in pipeline
+ *
+ *  The reader and lexer threads are started and the source is parsed
+ *  (by the caller thread) until the input is accepted or rejected.
+ *  The threads are stopped (joined) before the function returns;
+ *  note that the reader may be blocked in the source provider until
+ *  it returns.
+ *  The parsing results are available via the syntax analyser,
+ *  as usual.
+ *
+ *  The function may only be called once.
+ *
+ *  \param  pipe  Pipeline
+ *
+ *  \retval SA_OK              on success
+ *  \retval SA_SYNTAX_ERROR    if syntax error is detected (input is rejected)
+ *  \retval SA_ERROR           on general failure (incl. source error)
+ */
+sa_status_t sa_pipeline_parse(sa_pipeline_t *pipe);
+
+#endif /* end of #ifndef CTXFryer__sa_pipeline_h */
@@ -0,0 +1,120 @@
+#ifndef CTXFryer__spsc_queue_h
+#define CTXFryer__spsc_queue_h
+
+/**
+ *  \brief  Single-producer/single-consumer queue
+ *
+ *  Bounded queue of object pointers connecting 2 threads
+ *  (one of them pushes, the other one pops).
+ *
+ *  The queue is a ring buffer; the producer and the consumer
+ *  only share the ring head and tail indices, so as long as the queue
+ *  is neither full nor empty, no lock is taken.
+ *  Otherwise, the blocked side waits on a condition (the other side
+ *  only takes the lock to wake it up).
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <pthread.h>
+
+
+typedef struct spsc_queue spsc_queue_t;  /**< SPSC queue */
+
+
+/** SPSC queue */
+struct spsc_queue {
+    void            **impl;       /**< Ring buffer                      */
+    size_t            cap;        /**< Capacity                         */
+    size_t            head;       /**< Consumer position (atomic)       */
+    size_t            tail;       /**< Producer position (atomic)       */
+    int               waiting;    /**< Waiters count (atomic)           */
+    int               cancelled;  /**< Queue was cancelled (atomic)     */
+    pthread_mutex_t   mutex;      /**< Waiting lock                     */
+    pthread_cond_t    cond;       /**< Waiting condition                */
+};  /* end of struct spsc_queue */
+
+
+/**
+ *  \brief  Queue constructor
+ *
+ *  \param  queue  Queue (uninitialised object memory)
+ *  \param  cap    Capacity
+ *
+ *  \return Queue or \c NULL in case of memory error
+ */
+spsc_queue_t *spsc_queue_create(spsc_queue_t *queue, size_t cap);
+
+
+/**
+ *  \brief  Queue destructor
+ *
+ *  Note that the queued objects (if any) are not destroyed.
+ *
+ *  \param  queue  Queue
+ */
+void spsc_queue_destroy(spsc_queue_t *queue);
+
+
+/**
+ *  \brief  Push object to queue (producer)
+ *
+ *  Blocks while the queue is full.
+ *
+ *  \param  queue  Queue
+ *  \param  obj    Object
+ *
+ *  \retval 0          on success
+ *  \retval ECANCELED  if the queue was cancelled (the object isn't queued)
+ */
+int spsc_queue_push(spsc_queue_t *queue, void *obj);
+
+
+/**
+ *  \brief  Pop object from queue (consumer)
+ *
+ *  Blocks while the queue is empty.
+ *
+ *  \param  queue  Queue
+ *  \param  obj    Object
+ *
+ *  \retval 0          on success
+ *  \retval ECANCELED  if the queue was cancelled (and it's empty)
+ */
+int spsc_queue_pop(spsc_queue_t *queue, void **obj);
+
+
+/**
+ *  \brief  Cancel queue
+ *
+ *  Any side waiting on the queue is woken up; the producer can't push
+ *  any more objects (the consumer may still pop the queued ones).
+ *  This is used to stop a stage of a pipeline if the other one quits.
+ *
+ *  \param  queue  Queue
+ */
+void spsc_queue_cancel(spsc_queue_t *queue);
+
+#endif /* end of #ifndef CTXFryer__spsc_queue_h */
@@ -0,0 +1,219 @@
+#ifndef CTXFryer__srcdecomp_h
+#define CTXFryer__srcdecomp_h
+
+/**
+ *  \brief  Decompressing source
+ *
+ *  The module provides transparent decompression of compressed
+ *  source files (gzip or Zstandard).
+ *  The compressed data is read via the source file interface
+ *  (any segmentation mode, typically block or stream) and is
+ *  decompressed to data blocks which are provided via the buffer
+ *  interface, the same way as by \ref srcfile_next_buffer.
+ *  The buffers may therefore be fed to the lexical analyser
+ *  directly, without decompressing the source to disk first.
+ *
+ *  The output blocks are pooled (see \ref srcfile_block_pool_t);
+ *  they're returned to the pool when their buffers are destroyed,
+ *  so in steady state, there's no allocation per buffer.
+ *
+ *  Optionally, the decompression runs in a separate thread;
+ *  the decompressed blocks are passed to the reader via a (short)
+ *  bounded queue.
+ *  That way, decompression of the next block overlaps with lexical
+ *  analysis of the current one.
+ *  Note that in such case, the source file is only accessed from
+ *  the decompression thread (until closed).
+ *
+ *  Support for the compression formats depends on availability
+ *  of the respective libraries (zlib and libzstd) at build time.
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "srcfile.h"
+#include "buffer.h"
+
+#include <unistd.h>
+#include <pthread.h>
+
+
+/** Decompression queue size (for threaded decompression) */
+#define SRCDECOMP_QUEUE_SIZE 4
+
+
+typedef struct srcdecomp      srcdecomp_t;       /**< Decompressing source    */
+typedef struct srcdecomp_slot srcdecomp_slot_t;  /**< Decompressed block slot */
+
+
+/** Compression format */
+typedef enum {
+    SRCDECOMP_AUTO,  /**< Detect by magic number (uncompressed otherwise) */
+    SRCDECOMP_NONE,  /**< Uncompressed (data is just copied)              */
+    SRCDECOMP_GZIP,  /**< gzip (or zlib) format                            */
+    SRCDECOMP_ZSTD,  /**< Zstandard format                                 */
+} srcdecomp_format_t;  /* end of typedef enum */
+
+
+/** Decompressed block slot */
+struct srcdecomp_slot {
+    char   *data;  /**< Block data                      */
+    size_t  size;  /**< Block data size                 */
+    int     last;  /**< Last block flag                 */
+    int     erno;  /**< Error code (0 if no error)      */
+};  /* end of struct srcdecomp_slot */
+
+
+/** Decompressing source */
+struct srcdecomp {
+    srcfile_t            *srcf;        /**< Compressed source file               */
+    srcdecomp_format_t    format;      /**< Compression format                   */
+    size_t                block_size;  /**< Output block size                    */
+    int                   threaded;    /**< Decompress in separate thread        */
+    srcfile_block_pool_t *pool;        /**< Output block pool                    */
+    void                 *codec;       /**< Decompressor state                   */
+    int                   frame_end;   /**< Compressed frame is complete         */
+    buffer_t             *input;       /**< Current input buffer                 */
+    size_t                input_pos;   /**< Position in the current input buffer */
+    int                   input_eof;   /**< The last input buffer was read       */
+    int                   erno;        /**< Error code (sticky)                  */
+    int                   eof;         /**< The last block was provided          */
+    int                   running;     /**< Decompression thread is running      */
+    int                   stop;        /**< Decompression thread stop request    */
+    pthread_t             thread;      /**< Decompression thread                 */
+    pthread_mutex_t       mutex;       /**< Queue lock                           */
+    pthread_cond_t        not_empty;   /**< Queue isn't empty                    */
+    pthread_cond_t        not_full;    /**< Queue isn't full                     */
+    size_t                queue_head;  /**< Queue head index                     */
+    size_t                queue_cnt;   /**< Queue length                         */
+
+    srcdecomp_slot_t      queue[SRCDECOMP_QUEUE_SIZE];  /**< Decompressed blocks queue */
+};  /* end of struct srcdecomp */
+
+
+/**
+ *  \brief  Compression format getter
+ *
+ *  Note that the format is only known for sure after the source
+ *  is opened (if automatic detection was requested).
+ *
+ *  \param  dec  Decompressing source
+ *
+ *  \return Compression format
+ */
+#define srcdecomp_format(dec) ((dec)->format)
+
+
+/**
+ *  \brief  Check whether compression format is supported
+ *
+ *  \param  format  Compression format
+ *
+ *  \return Non-zero iff the format is supported (i.e. the library
+ *          was built with support for it)
+ */
+int srcdecomp_format_supported(srcdecomp_format_t format);
+
+
+/**
+ *  \brief  Decompressing source constructor
+ *
+ *  The source file must be created (but not open); it's opened
+ *  (and closed) by the decompressing source.
+ *  The source file object must exist until the decompressing source
+ *  is destroyed.
+ *
+ *  \param  dec         Decompressing source object
+ *  \param  srcf        Compressed source file
+ *  \param  format      Compression format
+ *  \param  block_size  Output block size
+ *  \param  threaded    Non-zero means decompression in separate thread
+ */
+void srcdecomp_create(srcdecomp_t *dec, srcfile_t *srcf, srcdecomp_format_t format,
+                      size_t block_size, int threaded);
+
+
+/**
+ *  \brief  Open decompressing source
+ *
+ *  Opens the source file, detects the compression format
+ *  (if requested) and initialises the decompressor.
+ *  In threaded mode, the decompression thread is started.
+ *
+ *  \param  dec  Decompressing source
+ *
+ *  \retval 0        on success
+ *  \retval ENOTSUP  if the compression format isn't supported
+ *  \retval ENOMEM   on memory error
+ *  \retval errno    on other error (see \ref srcfile_open)
+ */
+int srcdecomp_open(srcdecomp_t *dec);
+
+
+/**
+ *  \brief  Close decompressing source
+ *
+ *  In threaded mode, the decompression thread is stopped first
+ *  (note that it may be blocked reading from a stream until data
+ *  or end of stream is available).
+ *  The buffers provided may still be used.
+ *
+ *  \param  dec  Decompressing source
+ *
+ *  \retval 0      on success
+ *  \retval errno  on source file closing error
+ */
+int srcdecomp_close(srcdecomp_t *dec);
+
+
+/**
+ *  \brief  Decompressing source destructor
+ *
+ *  Closes the source unless already closed.
+ *
+ *  \param  dec  Decompressing source
+ */
+void srcdecomp_destroy(srcdecomp_t *dec);
+
+
+/**
+ *  \brief  Get next buffer of decompressed source
+ *
+ *  The function has the same semantics as \ref srcfile_next_buffer.
+ *  Every buffer (but possibly the last one) is a full output block.
+ *  The last buffer may be empty.
+ *
+ *  \param[in]   dec     Decompressing source
+ *  \param[out]  buffer  Source buffer
+ *  \param[out]  last    Last bit flag (optional, may be \c NULL)
+ *
+ *  \retval 0        on success
+ *  \retval ENODATA  if no more data may be read (aka EOF)
+ *  \retval EBADMSG  if the compressed data is corrupt or truncated
+ *  \retval ENOMEM   on memory error
+ *  \retval errno    on source file reading error
+ */
+int srcdecomp_next_buffer(srcdecomp_t *dec, buffer_t **buffer, int *last);
+
+#endif /* end of #ifndef CTXFryer__srcdecomp_h */
@@ -6,11 +6,13 @@
  *
  *  The module provides abstraction of work with source files.
  *
- *  Contents of a source file may be accessed in 3 ways via
+ *  Contents of a source file may be accessed in 5 ways via
  *  this module:
  *  1/ by mapping pages to memory
  *  2/ by reading blocks of octets
  *  3/ by reading ended lines
+ *  4/ by mapping the whole file to memory at once
+ *  5/ by reading blocks of octets from a stream (pipe, socket, ...)
  *
  *  The user may freely choose between these strategies; the data
  *  is always produced via the buffer interface, the only difference
@@ -46,13 +48,32 @@
  *  In such cases, each buffered line may only be kept in memory as long as
  *  the line processing takes and the run-time memory consumption may be
  *  really low even for large source files.
- *  Note that, however, this approach is quite inefficient in terms of time
- *  and should therefore only be used if time is not too much of an issue
- *  or the source line processing time is substantial and amortises
- *  the reading time well.
+ *  The file is read by blocks; line ends are found by \c memchr and
+ *  the lines are provided as slices of the (shared) block, so there's
+ *  no system call nor allocation per line.
+ *  A block is released as soon as all its lines are; lines longer
+ *  than the block are provided in a larger block.
  *  Also note that in circumstances described above, all the techniques
  *  will enable for quite efficient memory usage.
- *  Therefore, this one will probably be used least.
+ *
+ *  The 4th approach maps the whole file just once (when opened).
+ *  The mapping is advised for sequential access (and read-ahead)
+ *  and may optionally be pre-faulted and/or backed by transparent
+ *  huge pages.
+ *  The file is provided either in a single buffer or in windows
+ *  of the mapping (no system call is necessary per buffer);
+ *  pages of released windows are dropped from the mapping.
+ *  Unlike the paged mode, the whole file must fit in the address space.
+ *  The mapping is unmapped when the file is closed and all the buffers
+ *  are released.
+ *
+ *  The 5th approach is for non-seekable sources (pipes, sockets or std. input)
+ *  the size of which is unknown.
+ *  The source is read by blocks (as much as available, up to the block size,
+ *  at a time) until end of file is reached; the last buffer may therefore
+ *  be empty.
+ *  The buffers may be fed to the lexical analyser as soon as they're read
+ *  (see \c la_add_buffer).
  *
  *  The file is part of CTX Fryer C target language libraries.
  *
@@ -79,35 +100,94 @@
  */
 
 #include "buffer.h"
+#include "objpool.h"
 
 #include <unistd.h>
 #include <limits.h>
 #include <stdio.h>
+#include <pthread.h>
 
 #include <sys/stat.h>
 
 
-typedef struct srcfile srcfile_t;  /**< Source file */
+typedef struct srcfile            srcfile_t;             /**< Source file                  */
+typedef struct srcfile_map        srcfile_map_t;         /**< Source file (whole) mapping  */
+typedef struct srcfile_block_pool srcfile_block_pool_t;  /**< Source data block pool       */
+typedef struct srcfile_line_block srcfile_line_block_t;  /**< Source lines block           */
 
 
 /** Source file segmentation mode */
 typedef enum {
-    SRCFILE_SEG_PAGE,   /**< Source file segmented to pages  (see \c mmap)    */
-    SRCFILE_SEG_BLOCK,  /**< Source file segmented to blocks (see \c pread)   */
-    SRCFILE_SEG_LINE,   /**< Source file segmented to lines  (see \c getline) */
+    SRCFILE_SEG_PAGE,    /**< Source file segmented to pages    (see \c mmap)   */
+    SRCFILE_SEG_BLOCK,   /**< Source file segmented to blocks   (see \c pread)  */
+    SRCFILE_SEG_LINE,    /**< Source file segmented to lines    (see \c memchr) */
+    SRCFILE_SEG_WHOLE,   /**< Source file mapped as a whole     (see \c mmap)   */
+    SRCFILE_SEG_STREAM,  /**< Source stream segmented to blocks (see \c read)   */
 } srcfile_segmode_t;  /* end of typedef enum */
 
 
+/** Source file mapping flags (for whole segmentation, only) */
+typedef enum {
+    SRCFILE_MAP_POPULATE  = 0x1,  /**< Pre-fault the mapping      (see \c MAP_POPULATE) */
+    SRCFILE_MAP_HUGEPAGES = 0x2,  /**< Use transparent huge pages (see \c madvise)      */
+} srcfile_map_flags_t;  /* end of typedef enum */
+
+
+/** Source file (whole) mapping */
+struct srcfile_map {
+    char         *data;     /**< Mapped file        */
+    size_t        size;     /**< Mapping size       */
+    unsigned int  ref_cnt;  /**< Reference counter  */
+};  /* end of struct srcfile_map */
+
+
+/**
+ *  \brief  Source data block pool
+ *
+ *  Data blocks read in block segmentation mode are taken from the pool
+ *  and returned there when their buffers are destroyed (instead of
+ *  being allocated and freed).
+ *  The pool may be shared by source files (typically, a stream of
+ *  files is processed); it lives as long as any of the source files
+ *  or any of its blocks does.
+ *  The decompressing source takes its output blocks from such
+ *  a pool, too (see \ref srcdecomp_t).
+ *  The pool is thread-safe (buffers may be destroyed by other threads
+ *  than the reading one, see \ref sa_pipeline_t).
+ */
+struct srcfile_block_pool {
+    objpool_t        blocks;   /**< Data blocks       */
+    pthread_mutex_t  mutex;    /**< Pool lock         */
+    unsigned int     ref_cnt;  /**< Reference counter */
+};  /* end of struct srcfile_block_pool */
+
+
+/** Source lines block (lines are its slices) */
+struct srcfile_line_block {
+    char         *data;     /**< Block data                 */
+    size_t        size;     /**< Block size                 */
+    size_t        pos;      /**< Block position in the file */
+    unsigned int  ref_cnt;  /**< Reference counter          */
+};  /* end of struct srcfile_line_block */
+
+
 /** Source file */
 struct srcfile {
-    char               name[PATH_MAX];  /**< File name                                 */
-    srcfile_segmode_t  segmode;         /**< Segmentation mode                         */
-    int                fd;              /**< File descriptor                           */
-    size_t             pos;             /**< Current position in the source file       */
-    size_t             page_size;       /**< Page size  (for page  segmentation, only) */
-    size_t             block_size;      /**< Block size (for block segmentation, only) */
-    FILE              *file;            /**< File entry (for line  segmentation, only) */
-    struct stat        info;            /**< File info from FS                         */
+    char                  name[PATH_MAX];  /**< File name                                   */
+    srcfile_segmode_t     segmode;         /**< Segmentation mode                           */
+    int                   fd;              /**< File descriptor                             */
+    size_t                pos;             /**< Current position in the source file         */
+    size_t                page_size;       /**< Page size   (for page  segmentation, only)  */
+    size_t                block_size;      /**< Block size  (for block & line segmentation) */
+    srcfile_line_block_t *line_block;      /**< Lines block (for line  segmentation, only)  */
+    size_t                window_size;     /**< Window size (for whole segmentation, only)  */
+    int                   map_flags;       /**< Map flags   (for whole segmentation, only)  */
+    srcfile_map_t        *map;             /**< Mapping     (for whole segmentation, only)  */
+    srcfile_block_pool_t *block_pool;      /**< Block pool  (for block/stream segmentation) */
+    int                   direct_io;       /**< Direct I/O  (for block segmentation, only)  */
+    int                   stream_fd;       /**< Stream fd   (or -1 to open the file)        */
+    int                   eof;             /**< End of stream reached                       */
+    struct stat           info;            /**< File info from FS                           */
 };  /* end of struct srcfile */
 
 
@@ -166,21 +246,124 @@ size_t srcfile_page_size(void);
  *          and/or the last block may be shorter.
  *
  *  SRCFILE_SEG_LINE:
- *      (none)
+ *      \c size_t \c block_size
+ *          Size of blocks the lines are read by;
+ *          0 means the default (64 KiB).
+ *          Lines longer than that span more blocks.
+ *
+ *  SRCFILE_SEG_WHOLE:
+ *      \c size_t \c window_size_multiplier
+ *          Buffers (except the last) will have size of
+ *          \c window_size_multiplier \c * \c page_size;
+ *          0 means that the whole file is provided in one buffer.
+ *      \c int \c map_flags
+ *          Mapping flags (see \ref srcfile_map_flags_t)
+ *
+ *  SRCFILE_SEG_STREAM:
+ *      \c size_t \c max_block_size
+ *          Maximal size of data block.
+ *      \c int \c fd
+ *          Open file descriptor (e.g. \c STDIN_FILENO) or -1;
+ *          in the latter case, the file is opened by name (e.g. a FIFO).
+ *          The descriptor isn't closed by \ref srcfile_close.
  *
  *  \return
  */
 void srcfile_create(srcfile_t *srcf, const char *filename, srcfile_segmode_t segmode, ...);
 
 
+/**
+ *  \brief  Source data block pool constructor
+ *
+ *  Blocks are aligned to the \c align boundary; for direct I/O,
+ *  both the alignment and the block size should be multiples
+ *  of the file system logical block size (the system page size
+ *  is always a safe choice).
+ *
+ *  \param  block_size  Block size
+ *  \param  align       Block alignment (0 for default)
+ *  \param  cache_max   Max. amount of cached (free) blocks
+ *
+ *  \return Block pool (the caller holds its reference)
+ *          or \c NULL in case of memory error
+ */
+srcfile_block_pool_t *srcfile_block_pool_create(size_t block_size, size_t align, size_t cache_max);
+
+
+/**
+ *  \brief  Release source data block pool reference
+ *
+ *  The pool is destroyed with its last reference.
+ *
+ *  \param  pool  Block pool
+ */
+void srcfile_block_pool_release(srcfile_block_pool_t *pool);
+
+
+/**
+ *  \brief  Allocate data block from source data block pool
+ *
+ *  The block holds a pool reference (released when the block
+ *  is returned by \ref srcfile_block_pool_free).
+ *  The function is thread-safe.
+ *
+ *  \param  pool  Block pool
+ *
+ *  \return Data block or \c NULL in case of memory error
+ */
+char *srcfile_block_pool_alloc(srcfile_block_pool_t *pool);
+
+
+/**
+ *  \brief  Return data block to source data block pool
+ *
+ *  The block is returned to the pool and its pool reference
+ *  is released; if \c pool is \c NULL, the block is freed, instead.
+ *  The function is a \ref buffer_cleanup_fn (the pool is the buffer
+ *  user object), so it may be set as the block buffer cleanup routine.
+ *  The function is thread-safe.
+ *
+ *  \param  pool  Block pool (or \c NULL for dynamically allocated blocks)
+ *  \param  data  Data block
+ *  \param  size  Data block size (irrelevant)
+ */
+void srcfile_block_pool_free(void *pool, char *data, size_t size);
+
+
+/**
+ *  \brief  Set source file block pool
+ *
+ *  The function may only be called before the file is opened
+ *  (block or stream segmentation mode, only).
+ *  The file references the pool until closed.
+ *  If no pool is set, a private one is created when the file is opened.
+ *
+ *  If direct I/O is requested, the file is opened with \c O_DIRECT
+ *  (if supported by the file system, otherwise the flag is ignored).
+ *  The pool blocks must be aligned and the block size must be a multiple
+ *  of the alignment in such case.
+ *
+ *  \param  srcf       Source file
+ *  \param  pool       Block pool
+ *  \param  direct_io  Non-zero means direct I/O
+ *
+ *  \retval 0        on success
+ *  \retval EINVAL   if the pool blocks are too small or not aligned
+ *                   (for direct I/O) or direct I/O is requested
+ *                   for stream
+ *  \retval ENOTSUP  if direct I/O isn't supported on the platform
+ */
+int srcfile_set_block_pool(srcfile_t *srcf, srcfile_block_pool_t *pool, int direct_io);
+
+
 /**
  *  \brief  Open source file
  *
  *  The function MUST be called before source may be read
  *  from the source file.
- *  It opens the file read-only, creates file handler for
- *  line segmentation if necessary and obtains the file
+ *  It opens the file read-only and obtains the file
  *  information from the file system (namely its size).
+ *  In whole file mapping mode, the file is mapped, too.
  *
  *  \param  srcf  Source file
  *
@@ -63,9 +63,11 @@
 #include "attribute.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 
-#define SA_NULL_TARGET SIZE_MAX  /**< LR parser goto table invalid target */
+#define SA_NULL_TARGET16 UINT16_MAX  /**< 16-bit goto table invalid target */
+#define SA_NULL_TARGET32 UINT32_MAX  /**< 32-bit goto table invalid target */
 
 
 /** Syntax analyser status codes */
@@ -77,59 +79,70 @@ typedef enum {
 } sa_status_t;  /* end of typedef enum */
 
 
-/** LR parser action types */
+/**
+ *  \brief  LR parser action types
+ *
+ *  The values are the action code tags (see \ref sa_action_t).
+ */
 typedef enum {
-    SA_ACTION_SHIFT,   /**< Shift action  */
-    SA_ACTION_REDUCE,  /**< Reduce action */
-    SA_ACTION_ACCEPT,  /**< Accept action */
-    SA_ACTION_REJECT,  /**< Reject action */
+    SA_ACTION_REJECT = 0,  /**< Reject action */
+    SA_ACTION_SHIFT  = 1,  /**< Shift action  */
+    SA_ACTION_REDUCE = 2,  /**< Reduce action */
+    SA_ACTION_ACCEPT = 3,  /**< Accept action */
 } sa_action_type_t;  /* end of typedef enum */
 
 
-typedef struct sa_action sa_action_t;  /**< LR parser action          */
-typedef struct sa_state  sa_state_t;   /**< Syntax analyser state     */
-typedef struct sa_stack  sa_stack_t;   /**< Syntax analyser PDA stack */
-typedef struct syxa      syxa_t;       /**< Syntax analyser           */
+#define SA_ACTION_TAG_BITS 2  /**< Action code tag bits     */
+#define SA_ACTION_TAG_MASK 3  /**< Action code tag bit mask */
+
+
+/**
+ *  \brief  LR parser action (packed)
+ *
+ *  The action type is stored in the lowest \ref SA_ACTION_TAG_BITS
+ *  (the tag), the shift action next state or the reduce action rule
+ *  number in the rest.
+ *  Zero code means reject, so that empty table cells need no entry.
+ */
+typedef uint32_t sa_action_t;
 
-typedef struct sa_action_shift  sa_action_shift_t;   /**< Shift  action */
-typedef struct sa_action_reduce sa_action_reduce_t;  /**< Reduce action */
-typedef struct sa_action_accept sa_action_accept_t;  /**< Accept action */
+typedef struct sa_state       sa_state_t;        /**< Syntax analyser state     */
+typedef struct sa_stack       sa_stack_t;        /**< Syntax analyser PDA stack */
+typedef struct sa_value_stack sa_value_stack_t;  /**< Semantic values stack     */
+typedef struct syxa           syxa_t;            /**< Syntax analyser           */
 
 typedef struct lr1_action_tab lr1_action_tab_t;  /**< LR(1) parser action    table */
 typedef struct lr1_goto_tab   lr1_goto_tab_t;    /**< LR(1) parser goto      table */
 typedef struct lr1_rule_tab   lr1_rule_tab_t;    /**< LR(1) parser rule info table */
 
-typedef struct attribute_tab attribute_tab_t;  /**< Attribute definitions */
-
-
-/** Shift action */
-struct sa_action_shift {
-    size_t next_state;  /**< Next state number (after the item shift) */
-};  /* end of struct sa_action_shift */
-
-
-/** Reduce action */
-struct sa_action_reduce {
-    size_t rule_no;  /**< Reduce rule number */
-};  /* end of struct sa_action_reduce */
-
-
-/** Accept action */
-struct sa_action_accept {
-};  /* end of struct sa_action_accept */
+typedef struct sa_value_tab   sa_value_tab_t;    /**< Semantic values handlers  */
+typedef struct sa_event       sa_event_t;        /**< Parsing event             */
 
+typedef struct attribute_tab attribute_tab_t;  /**< Attribute definitions */
 
-/** LR parser action */
-struct sa_action {
-    sa_action_type_t type;  /**< Action type */
 
-    /** Action implementation */
-    union {
-        sa_action_shift_t  shift;   /**< Shift  action */
-        sa_action_reduce_t reduce;  /**< Reduce action */
-        sa_action_accept_t accept;  /**< Accept action */
-    } t;  /* end of anonymous union */
-};  /* end of struct sa_action */
+/**
+ *  \brief  Direct-coded LR parser prototype
+ *
+ *  The parser has the same semantics as \ref sa_parse; it's
+ *  generated as a function with a label per parser state, where
+ *  the shift/reduce decision is a \c switch over the look-ahead
+ *  and state transitions are \c goto jumps.
+ *  The parser resumes in the state on the PDA stack top,
+ *  so it may be called again after input exhaustion.
+ *
+ *  The parser uses \ref sa_read_items, \ref sa_shift, \ref sa_reduce,
+ *  \ref sa_goto and \ref sa_accept_input to keep the syntax analyser
+ *  state consistent with the table-driven parsing.
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \retval SA_OK              on success
+ *  \retval SA_INPUT_EXHAUSTED if more input data is required to proceed
+ *  \retval SA_SYNTAX_ERROR    if syntax error is detected (input is rejected)
+ *  \retval SA_ERROR           on general failure
+ */
+typedef sa_status_t sa_direct_parse_fn(syxa_t *sa);
 
 
 /*
@@ -137,49 +150,44 @@ struct sa_action {
  */
 
 /**
- *  \brief  Shift action initialiser
+ *  \brief  Shift action code
  *
  *  \param  next_state  Next state
  */
 #define SA_ACTION_SHIFT_INIT(next_state) \
-    { \
-        .type = SA_ACTION_SHIFT, \
-        .t.shift.next_state = (next_state), \
-    }
+    (((next_state) << SA_ACTION_TAG_BITS) | SA_ACTION_SHIFT)
 
 
 /**
- *  \brief  Reduce action initialiser
+ *  \brief  Reduce action code
  *
  *  \param  rule_no  Reduce rule number
  */
 #define SA_ACTION_REDUCE_INIT(rule_no) \
-    { \
-        .type = SA_ACTION_REDUCE, \
-        .t.reduce.rule_no = (rule_no), \
-    }
+    (((rule_no) << SA_ACTION_TAG_BITS) | SA_ACTION_REDUCE)
+
+
+/**
+ *  \brief  Accept action code
+ */
+#define SA_ACTION_ACCEPT_INIT SA_ACTION_ACCEPT
 
 
 /**
- *  \brief  Accept action initialiser
+ *  \brief  Reject action code
  */
-#define SA_ACTION_ACCEPT_INIT \
-    { \
-        .type = SA_ACTION_ACCEPT, \
-    }
+#define SA_ACTION_REJECT_INIT SA_ACTION_REJECT
 
 
 /**
  *  \brief  LR action type getter
  *
- *  Note that \c NULL action stands for reject action.
- *
  *  \param  action  LR action
  *
  *  \return LR action type
  */
 #define sa_action_type(action) \
-    (NULL != (action) ? (action)->type : SA_ACTION_REJECT)
+    ((sa_action_type_t)((action) & SA_ACTION_TAG_MASK))
 
 
 /**
@@ -189,7 +197,8 @@ struct sa_action {
  *
  *  \return Next state after shift
  */
-#define sa_action_shift_next_state(action) ((action)->t.shift.next_state)
+#define sa_action_shift_next_state(action) \
+    ((size_t)((action) >> SA_ACTION_TAG_BITS))
 
 
 /**
@@ -199,22 +208,79 @@ struct sa_action {
  *
  *  \return Reduce rule number
  */
-#define sa_action_reduce_rule_no(action) ((action)->t.reduce.rule_no)
+#define sa_action_reduce_rule_no(action) \
+    ((size_t)((action) >> SA_ACTION_TAG_BITS))
 
 
-/** LR(1) parser action table */
+/**
+ *  \brief  LR(1) parser action table
+ *
+ *  The table is a dense \c state x \c lex_item matrix of action codes.
+ *  The code width (16 or 32 bits) is chosen by the generator
+ *  (the narrowest one holding all the states and rule numbers).
+ *
+ *  States which only reduce by a single rule (whatever the look-ahead)
+ *  have the reduction set as their default action; the parser does it
+ *  without reading the input (see \ref sa_action_table_default).
+ *
+ *  If the parser is generated in the direct-coded form, it's set
+ *  in the table and \ref sa_parse calls it instead of interpreting
+ *  the tables.
+ *  The action and goto tables implementations aren't needed then;
+ *  the generator leaves them out (they're \c NULL).
+ */
 struct lr1_action_tab {
     size_t              state_cnt;     /**< LR(1) parser state count            */
     size_t              lex_item_cnt;  /**< Lexical items count (including EoF) */
-    const sa_action_t * (* impl)[];    /**< Table implementation                */
+    size_t              width;         /**< Action code width (2 or 4 bytes)    */
+    sa_direct_parse_fn *parse;         /**< Direct-coded parser (or NULL)       */
+
+    /** Table implementation */
+    union {
+        const uint16_t *w16;  /**< 16-bit action codes */
+        const uint32_t *w32;  /**< 32-bit action codes */
+    } impl;
+
+    /** Default actions (per state; optional) */
+    union {
+        const uint16_t *w16;  /**< 16-bit action codes */
+        const uint32_t *w32;  /**< 32-bit action codes */
+    } dflt;
 };  /* end of struct lr1_action_tab */
 
 
-/** LR(1) parser goto table */
+/**
+ *  \brief  LR(1) parser goto table
+ *
+ *  The table is a dense \c state x \c non_term matrix of next states;
+ *  the entry width is chosen the same way as in the action table.
+ *  Invalid targets are \ref SA_NULL_TARGET16 or \ref SA_NULL_TARGET32.
+ *  The implementation is \c NULL if the parser is direct-coded
+ *  (see \ref lr1_action_tab_t).
+ *
+ *  The generator may skip reductions by chain rules (A => B, with
+ *  attributes of A copied from B); goto to the state reducing by such
+ *  a rule is replaced by the goto after the reduction.
+ *  The B parse tree node then stands for the A node.
+ *  This is only done if requested (\c --eliminate-chain-rules option
+ *  of \c ctx-fryer-cfg2parser).
+ *
+ *  IMPORTANT: the skipped reductions never happen at run time,
+ *  so no reduce callbacks (see \ref sa_value_tab_t) are called
+ *  and no reduce events (see \ref sa_set_event_handler) are produced
+ *  for the chain rules.
+ *  Don't enable the elimination if you rely on them.
+ */
 struct lr1_goto_tab {
-    size_t       state_cnt;     /**< LR(1) parser state count    */
-    size_t       non_term_cnt;  /**< Grammar non-terminals count */
-    const size_t (* impl)[];    /**< Table implementation        */
+    size_t state_cnt;     /**< LR(1) parser state count    */
+    size_t non_term_cnt;  /**< Grammar non-terminals count */
+    size_t width;         /**< Entry width (2 or 4 bytes)  */
+
+    /** Table implementation */
+    union {
+        const uint16_t *w16;  /**< 16-bit next states */
+        const uint32_t *w32;  /**< 32-bit next states */
+    } impl;
 };  /* end of struct lr1_goto_tab */
 
 
@@ -225,10 +291,135 @@ struct lr1_rule_tab {
 };  /* end of struct lr1_rule_tab */
 
 
+/*
+ * Semantic values
+ */
+
+/**
+ *  \brief  Terminal symbol semantic value constructor prototype
+ *
+ *  Called when a lexical item is shifted.
+ *  Note that the item is under control of the lexical analyser;
+ *  copy it (see \ref la_item_copy) to get its token.
+ *
+ *  \param[out]  value     Terminal symbol value
+ *  \param[in]   item      Lexical item shifted
+ *  \param[in]   user_obj  User object
+ *
+ *  \retval 0     on success
+ *  \retval errno on error (parsing fails)
+ */
+typedef int sa_shift_value_fn(void **value, const la_item_t *item, void *user_obj);
+
+
+/**
+ *  \brief  Grammar rule reduction callback prototype
+ *
+ *  Called when the parser reduces by the rule; the right-hand side
+ *  symbols values are passed over to the callback (it shall destroy
+ *  those that aren't passed on in the left-hand side value).
+ *  That's also the case if the callback fails.
+ *
+ *  \param[out]  value     Left-hand side symbol value
+ *  \param[in]   rhs       Right-hand side symbols values
+ *  \param[in]   user_obj  User object
+ *
+ *  \retval 0     on success
+ *  \retval errno on error (parsing fails)
+ */
+typedef int sa_reduce_value_fn(void **value, void *rhs[], void *user_obj);
+
+
+/**
+ *  \brief  Semantic value destructor prototype
+ *
+ *  Called for values left on the stack (after parsing failure)
+ *  or dropped by the default reduction; \c NULL values aren't passed.
+ *
+ *  \param  value     Value
+ *  \param  user_obj  User object
+ */
+typedef void sa_value_destroy_fn(void *value, void *user_obj);
+
+
+/**
+ *  \brief  Semantic values handlers
+ *
+ *  Reduce callbacks are indexed by grammar rule numbers.
+ *  If a rule has no callback, the left-hand side symbol value
+ *  is the 1st right-hand side symbol value (the others are destroyed)
+ *  or \c NULL for empty rules.
+ *  If there's no terminal value constructor, terminal values are \c NULL.
+ *
+ *  Note that callbacks of chain rules skipped by the goto table
+ *  (see \ref lr1_goto_tab_t) are never called.
+ */
+struct sa_value_tab {
+    sa_shift_value_fn   *shift;     /**< Terminal value constructor (or NULL) */
+    sa_value_destroy_fn *destroy;   /**< Value destructor (or NULL)           */
+    size_t               rule_cnt;  /**< Grammar rule count                   */
+    sa_reduce_value_fn  *reduce[];  /**< Reduce callbacks (or NULLs)          */
+};  /* end of struct sa_value_tab */
+
+
+/*
+ * Parsing events
+ */
+
+/** Parsing event types */
+typedef enum {
+    SA_EVENT_SHIFT = 0,  /**< Lexical item was shifted           */
+    SA_EVENT_REDUCE,     /**< Reduction by grammar rule was done */
+} sa_event_type_t;  /* end of typedef enum */
+
+
+/**
+ *  \brief  Parsing event
+ *
+ *  The shift event item is a copy owned by the parser; it's valid
+ *  during the handler call (so that its token may be taken, see
+ *  \ref la_item_token).
+ *  Copy it (see \ref la_item_copy) if it's needed afterwards.
+ */
+struct sa_event {
+    sa_event_type_t type;  /**< Event type                          */
+    size_t          rule;  /**< Grammar rule number (reduce event)  */
+    la_item_t       item;  /**< Lexical item shifted (shift event)  */
+};  /* end of struct sa_event */
+
+
+/**
+ *  \brief  Parsing events handler prototype
+ *
+ *  The events are passed in the order they happened.
+ *
+ *  \param  events     Events
+ *  \param  event_cnt  Events count
+ *  \param  user_obj   User object
+ *
+ *  \retval 0     on success
+ *  \retval errno on error (parsing fails)
+ */
+typedef int sa_event_fn(sa_event_t *events, size_t event_cnt, void *user_obj);
+
+
 /*
  * LR(1) parser tables interface
  */
 
+/**
+ *  \brief  LR(1) parser table cell (of either width)
+ *
+ *  \param  tab  Action or goto table
+ *  \param  idx  Cell index
+ *
+ *  \return Cell value
+ */
+#define sa_lr1_table_cell(tab, idx) \
+    (2 == (tab)->width \
+        ? (uint32_t)(tab)->impl.w16[(idx)] \
+        : (tab)->impl.w32[(idx)])
+
 /**
  *  \brief  LR(1) parser action table accessor
  *
@@ -243,7 +434,36 @@ struct lr1_rule_tab {
 #define sa_action_table_at(action_tab, state, item_code) \
     (assert((state)     < (action_tab)->state_cnt), \
      assert((item_code) < (action_tab)->lex_item_cnt), \
-     (*(*((action_tab)->impl) + ((action_tab)->lex_item_cnt * (state) + (item_code)))))
+     sa_lr1_table_cell((action_tab), \
+         (action_tab)->lex_item_cnt * (state) + (item_code)))
+
+
+/**
+ *  \brief  LR(1) parser default action accessor
+ *
+ *  \param  action_tab  Action table
+ *  \param  state       State
+ *
+ *  \return Reduce action to perform in \c state regardless of the input
+ *          (reject action code if the input must be read)
+ */
+#define sa_action_table_default(action_tab, state) \
+    (assert((state) < (action_tab)->state_cnt), \
+     NULL != (action_tab)->dflt.w16 \
+        ? (2 == (action_tab)->width \
+            ? (uint32_t)(action_tab)->dflt.w16[(state)] \
+            : (action_tab)->dflt.w32[(state)]) \
+        : SA_ACTION_REJECT_INIT)
+
+
+/**
+ *  \brief  LR(1) parser direct-coded form getter
+ *
+ *  \param  action_tab  Action table
+ *
+ *  \return The direct-coded parser or \c NULL if not available
+ */
+#define sa_action_table_parse(action_tab) ((action_tab)->parse)
 
 
 /**
@@ -259,7 +479,19 @@ struct lr1_rule_tab {
 #define sa_goto_table_at(goto_tab, state, non_term) \
     (assert((state)    < (goto_tab)->state_cnt), \
      assert((non_term) < (goto_tab)->non_term_cnt), \
-     (*(*((goto_tab)->impl) + ((goto_tab)->non_term_cnt * (state) + (non_term)))))
+     (size_t)sa_lr1_table_cell((goto_tab), \
+         (goto_tab)->non_term_cnt * (state) + (non_term)))
+
+
+/**
+ *  \brief  LR(1) parser goto table invalid target
+ *
+ *  \param  goto_tab  Goto table
+ *
+ *  \return \ref SA_NULL_TARGET16 or \ref SA_NULL_TARGET32 (as per width)
+ */
+#define sa_goto_table_null_target(goto_tab) \
+    ((size_t)(2 == (goto_tab)->width ? SA_NULL_TARGET16 : SA_NULL_TARGET32))
 
 
 /**
@@ -383,26 +615,51 @@ struct sa_stack {
 };  /* end of struct sa_stack */
 
 
+/**
+ *  \brief  Semantic values stack
+ *
+ *  The stack is kept in parallel to the PDA stack (the initial state
+ *  has no value); its depth is therefore bounded by the PDA stack limit.
+ */
+struct sa_value_stack {
+    size_t  depth;  /**< Stack current depth      */
+    void  **impl;   /**< Stack implementation     */
+    size_t  cap;    /**< Stack capacity           */
+};  /* end of struct sa_value_stack */
+
+
 /** Syntax analyser state */
 struct sa_state {
-    int           accept;        /**< Accept flag       */
-    sa_stack_t    pda_stack;     /**< PDA stack         */
-    sa_stack_t    reduct_stack;  /**< Word reduction    */
-    ptree_node_t *ptree;         /**< Parse tree handle */
+    int              accept;        /**< Accept flag       */
+    sa_stack_t       pda_stack;     /**< PDA stack         */
+    sa_stack_t       reduct_stack;  /**< Word reduction    */
+    sa_value_stack_t value_stack;   /**< Semantic values   */
+    ptree_node_t    *ptree;         /**< Parse tree handle */
 };  /* end of struct sa_state */
 
 
 /** Syntax analyser */
 struct syxa {
-    const lr1_action_tab_t *action_tab;  /**< LR(1) parser action    table              */
-    const lr1_goto_tab_t   *goto_tab;    /**< LR(1) parser goto      table              */
-    const lr1_rule_tab_t   *rule_tab;    /**< LR(1) parser rule info table              */
-    const attribute_tab_t  *attr_tab;    /**< Attribute definitions  table              */
-    lexa_t                  la;          /**< Lexical analyser (input segmenter)        */
-    int                     reduct_log;  /**< Non-zero means that reduction is logged   */
-    int                     ptree;       /**< Non-zero means that parse tree is created */
-    sa_state_t              state;       /**< State                                     */
-    sa_status_t             status;      /**< Status                                    */
+    const lr1_action_tab_t *action_tab;   /**< LR(1) parser action    table                */
+    const lr1_goto_tab_t   *goto_tab;     /**< LR(1) parser goto      table                */
+    const lr1_rule_tab_t   *rule_tab;     /**< LR(1) parser rule info table                */
+    const attribute_tab_t  *attr_tab;     /**< Attribute definitions  table                */
+    const sa_value_tab_t   *value_tab;    /**< Semantic values handlers (or NULL)          */
+    void                   *value_obj;    /**< Semantic values handlers user object        */
+    sa_event_fn            *event_fn;     /**< Parsing events handler (or NULL)            */
+    void                   *event_obj;    /**< Parsing events handler user object          */
+    sa_event_t             *events;       /**< Pending events ring                         */
+    size_t                  event_cap;    /**< Pending events ring size                    */
+    size_t                  event_cnt;    /**< Pending events count                        */
+    sa_event_t              event;        /**< Event (if no ring is provided)              */
+    lexa_t                  la;           /**< Lexical analyser (input segmenter)          */
+    const la_item_t        *input_items;  /**< Lexical items input (see \ref sa_set_items) */
+    size_t                  input_cnt;    /**< Lexical items input length                  */
+    int                     input_code;   /**< Last shifted input item code                */
+    int                     reduct_log;   /**< Non-zero means that reduction is logged     */
+    int                     ptree;        /**< Non-zero means that parse tree is created   */
+    sa_state_t              state;        /**< State                                       */
+    sa_status_t             status;       /**< Status                                      */
 };  /* end of struct syxa */
 
 
@@ -430,6 +687,26 @@ struct syxa {
 #define sa_ptree_enabled(sa) ((sa)->ptree)
 
 
+/**
+ *  \brief  Semantic values stack enabled check
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \return Non-zero iff semantic values are computed
+ */
+#define sa_values_enabled(sa) (NULL != (sa)->value_tab)
+
+
+/**
+ *  \brief  Parsing events enabled check
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \return Non-zero iff parsing events are delivered
+ */
+#define sa_events_enabled(sa) (NULL != (sa)->event_fn)
+
+
 /**
  *  \brief  Add another source buffer
  *
@@ -535,11 +812,50 @@ void sa_destroy(syxa_t *sa);
 sa_status_t sa_add_data(syxa_t *sa, char *data, size_t size, buffer_cleanup_fn *cleanup_fn, void *user_obj, int is_last);
 
 
+/**
+ *  \brief  Feed lexical items
+ *
+ *  Instead of reading the source via its lexical analyser,
+ *  the parser shall shift the lexical items provided (in order).
+ *  Consecutive items of the same offset are alternatives (as provided
+ *  by \ref la_get_items); the parser chooses one of them as usual
+ *  and skips the rest.
+ *  Code of the shifted item is available via \ref sa_shifted_item_code
+ *  (so that the lexical analyser producing the items may follow
+ *  the parser choice, see \ref sa_pipeline_t).
+ *
+ *  When the items are shifted, \ref sa_parse reports input exhaustion;
+ *  the function may be called again to feed more items.
+ *  The parser doesn't take over the items (the parse tree keeps their
+ *  copies); they must be valid until they're shifted (or the parsing
+ *  ends).
+ *  Note that the items must end by the \ref LEXIG_EOF item.
+ *
+ *  \param  sa        Syntax analyser
+ *  \param  items     Lexical items
+ *  \param  item_cnt  Lexical items count
+ */
+void sa_set_items(syxa_t *sa, const la_item_t *items, size_t item_cnt);
+
+
+/**
+ *  \brief  Last shifted fed lexical item code
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \return Code of the last item shifted from \ref sa_set_items input
+ *          (\ref LEXIG_INVALID if none was shifted)
+ */
+#define sa_shifted_item_code(sa) ((sa)->input_code)
+
+
 /**
  *  \brief  Parse source
  *
  *  The \c sa_parse routine performs greedy parsing of the input,
  *  i.e. it parses until the input is accepted/rejected or exhausted.
+ *  If the parser is direct-coded (see \ref sa_action_table_parse),
+ *  it's called; otherwise, the action and goto tables are interpreted.
  *
  *  \param  sa  Syntax analyser
  *
@@ -551,6 +867,95 @@ sa_status_t sa_add_data(syxa_t *sa, char *data, size_t size, buffer_cleanup_fn *
 sa_status_t sa_parse(syxa_t *sa);
 
 
+/*
+ * Direct-coded parser interface
+ * (see \ref sa_direct_parse_fn)
+ *
+ * The functions set the syntax analyser status and return it.
+ */
+
+/**
+ *  \brief  Current parser state
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \return State on the PDA stack top
+ */
+#define sa_current_state(sa) \
+    ((sa)->state.pda_stack.impl[(sa)->state.pda_stack.depth - 1])
+
+
+/**
+ *  \brief  Get lexical item(s) on the input head
+ *
+ *  More items mean alternatives; the parser shall choose
+ *  the 1st one it has an action for.
+ *
+ *  \param[in]   sa        Syntax analyser
+ *  \param[out]  items     Lexical items
+ *  \param[out]  item_cnt  Lexical items count
+ *
+ *  \retval SA_OK              if the item(s) are available
+ *  \retval SA_INPUT_EXHAUSTED if input is exhausted
+ *  \retval SA_SYNTAX_ERROR    if there is a lexical error in the input
+ *  \retval SA_ERROR           on other failure
+ */
+sa_status_t sa_read_items(syxa_t *sa, const la_item_t **items, size_t *item_cnt);
+
+
+/**
+ *  \brief  Shift lexical item
+ *
+ *  \param  sa          Syntax analyser
+ *  \param  next_state  Next state
+ *  \param  item        Lexical item chosen
+ *  \param  item_cnt    Lexical items count (on the input head)
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (PDA stack overflow, memory error)
+ */
+sa_status_t sa_shift(syxa_t *sa, size_t next_state, const la_item_t *item, size_t item_cnt);
+
+
+/**
+ *  \brief  Reduce by grammar rule
+ *
+ *  The rule right-hand side states are popped from the PDA stack;
+ *  the caller shall push the goto target (see \ref sa_goto).
+ *
+ *  \param[in]   sa     Syntax analyser
+ *  \param[in]   rule   Grammar rule
+ *  \param[out]  state  State uncovered on the PDA stack top
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (reduction log overflow, memory error)
+ */
+sa_status_t sa_reduce(syxa_t *sa, const grammar_rule_t *rule, size_t *state);
+
+
+/**
+ *  \brief  Go to state after reduction
+ *
+ *  \param  sa          Syntax analyser
+ *  \param  next_state  Next state
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (PDA stack overflow, memory error)
+ */
+sa_status_t sa_goto(syxa_t *sa, size_t next_state);
+
+
+/**
+ *  \brief  Accept the input
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (parse tree completion)
+ */
+sa_status_t sa_accept_input(syxa_t *sa);
+
+
 /**
  *  \brief  Derivation getter
  *
@@ -568,6 +973,10 @@ sa_status_t sa_parse(syxa_t *sa);
  *  but if called incrementally, the caller must invert
  *  the bits sequence on his own.
  *
+ *  Note that the log grows with the input; consumers that only need
+ *  to follow the reductions may disable it and receive them as they
+ *  happen, instead (see \ref sa_set_event_handler).
+ *
  *  \param  sa              Syntax analyser
  *  \param  derivation_len  Length of the derivation
  *
@@ -595,4 +1004,75 @@ size_t *sa_derivation(syxa_t *sa, size_t *derivation_len);
  */
 ptree_node_t *sa_handover_ptree(syxa_t *sa);
 
+
+/**
+ *  \brief  Enable semantic values computation
+ *
+ *  The semantic values are kept on a stack parallel to the PDA stack;
+ *  the handlers are called as the parser shifts and reduces,
+ *  so the translation needs neither the parse tree nor the reduction
+ *  log (yacc-style).
+ *  Memory required is bounded by the stack depth.
+ *
+ *  The function must be called before parsing begins.
+ *  The handlers table must be available during the syntax analyser
+ *  lifetime.
+ *
+ *  \param  sa         Syntax analyser
+ *  \param  value_tab  Semantic values handlers
+ *  \param  user_obj   User object (passed to the handlers)
+ *
+ *  \retval 0      on success
+ *  \retval ENOMEM on memory error
+ */
+int sa_set_value_tab(syxa_t *sa, const sa_value_tab_t *value_tab, void *user_obj);
+
+
+/**
+ *  \brief  Hand over the root semantic value
+ *
+ *  The function provides the parsed source root symbol value
+ *  (if the source was accepted by the analyser and
+ *  semantic values are enabled).
+ *
+ *  By calling this function, the value possession
+ *  is passed from the parser to the caller.
+ *  Subsequent calls will return \c NULL.
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \return Root symbol value (or \c NULL)
+ */
+void *sa_handover_value(syxa_t *sa);
+
+/**
+ *  \brief  Enable parsing events delivery
+ *
+ *  The handler is called with the shift and reduce events as the parser
+ *  proceeds (SAX-style).
+ *  With the reduction log and parse tree creation disabled, arbitrarily
+ *  long input may be processed in memory bounded by the PDA stack depth.
+ *
+ *  If the events ring is provided, the events are batched in it;
+ *  the handler is called when the ring is full and at the end of each
+ *  \ref sa_parse call (i.e. also when the input is exhausted, accepted
+ *  or rejected).
+ *  Otherwise, each event is passed to the handler as it happens.
+ *  The ring is reused; events passed to the handler are invalidated
+ *  when it returns.
+ *
+ *  Note that reductions by chain rules skipped by the goto table
+ *  (see \ref lr1_goto_tab_t) produce no events.
+ *
+ *  The function must be called before parsing begins.
+ *  The ring must be available during the syntax analyser lifetime.
+ *
+ *  \param  sa         Syntax analyser
+ *  \param  handler    Parsing events handler
+ *  \param  user_obj   User object (passed to the handler)
+ *  \param  ring       Events ring (or \c NULL)
+ *  \param  ring_size  Events ring size
+ */
+void sa_set_event_handler(syxa_t *sa, sa_event_fn *handler, void *user_obj, sa_event_t *ring, size_t ring_size);
+
 #endif /* end of #ifndef CTXFryer__syntax_analyser_h */
@@ -39,6 +39,26 @@
 typedef void token_t;  /**< Lexical token opaque handle */
 
 
+/**
+ *  \brief  Lexical token fragments iterator
+ *
+ *  Token data may span multiple source buffers.
+ *  The iterator provides the token fragments (in order)
+ *  without the data being copied.
+ *  See \ref token_iov and \ref token_iov_next.
+ *
+ *  The members are private.
+ */
+struct token_iov {
+    const void *buffer;  /**< Current fragment buffer         */
+    const char *data;    /**< Inline token (if no buffer)     */
+    size_t      offset;  /**< Current fragment buffer offset  */
+    size_t      to_go;   /**< Token length yet to be provided */
+};  /* end of struct token_iov */
+
+typedef struct token_iov token_iov_t;  /**< Lexical token fragments iterator */
+
+
 /** Lexical token conversion status */
 typedef enum {
     TOKEN_CONV_OK = 0,          /**< Successful conversion    */
@@ -71,6 +91,8 @@ typedef enum {
  *  However, necessity for allocation should be very rare in practice.
  *  The defragmented token is cached for repeated direct usage in future
  *  of course, so it occurs at most once.
+ *  If you only need to inspect the token, consider using \ref token_iov,
+ *  \ref token_compare or \ref token_hash which never allocate.
  *
  *  \param  token  Token
  *
@@ -110,6 +132,77 @@ const char *token_data(token_t *token);
 char *token_string(token_t *token);
 
 
+/**
+ *  \brief  Initialise lexical token fragments iterator
+ *
+ *  Unlike \ref token_data, the function never defragments
+ *  the token; no memory allocation takes place.
+ *  The fragments are only valid as long as the parse tree is.
+ *
+ *  Usage:
+ *  \code
+ *  token_iov_t iov;
+ *  const char *frag;
+ *  size_t      frag_len;
+ *
+ *  token_iov(token, &iov);
+ *
+ *  while (token_iov_next(&iov, &frag, &frag_len)) {
+ *      ...
+ *  }
+ *  \endcode
+ *
+ *  \param  token  Token
+ *  \param  iov    Fragments iterator
+ */
+void token_iov(token_t *token, token_iov_t *iov);
+
+
+/**
+ *  \brief  Get next lexical token fragment
+ *
+ *  \param  iov     Fragments iterator
+ *  \param  data    Fragment data
+ *  \param  length  Fragment length
+ *
+ *  \return Non-zero if a fragment was provided, 0 at token end
+ */
+int token_iov_next(token_iov_t *iov, const char **data, size_t *length);
+
+
+/**
+ *  \brief  Compare lexical token with data
+ *
+ *  The function compares the token data with a raw char. buffer
+ *  in the manner of \c memcmp; shorter prefix of the other compares
+ *  lower.
+ *  Token fragments are compared directly (no allocation takes place).
+ *
+ *  \param  token   Token
+ *  \param  data    Compared data
+ *  \param  length  Compared data length
+ *
+ *  \return Negative, zero or positive integer if the token is lower,
+ *          equal or greater than the data, respectively
+ */
+int token_compare(token_t *token, const char *data, size_t length);
+
+
+/**
+ *  \brief  Lexical token hash
+ *
+ *  FNV-1a hash of the token data computed over the token
+ *  fragments (no allocation takes place).
+ *  The hash only depends on the token data, not on its
+ *  fragmentation.
+ *
+ *  \param  token  Token
+ *
+ *  \return Token hash
+ */
+size_t token_hash(token_t *token);
+
+
 /**
  *  \brief  Get lexical token length
  *
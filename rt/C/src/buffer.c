@@ -6,8 +6,12 @@
  *  and namely to avoid keeping large amounts of data in memory during
  *  parsing (buffers that are no longer referenced are destroyed,
  *  automatically).
- *  For this reason, the \ref buffer_t objects are cached so that
- *  their allocation costs are amortised as much as possible.
+ *  Buffers may be passed between threads (and destroyed by another
+ *  thread than the one that created them); the reference counter
+ *  is atomic.
+ *  The buffer objects are allocated by the system allocator
+ *  (which caches memory per thread), so that creation and destruction
+ *  of buffers in different threads isn't serialised.
  *
  *  The file is part of CTX Fryer C target language libraries.
  *
@@ -34,28 +38,50 @@
  */
 
 #include "buffer.h"
-#include "objpool.h"
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-#define BUFFER_RESERVE_MAX  32  /**< Max. amount of cached buffer objects   */
-#define BUFFER_PREALLOC      4  /**< Amount of pre-allocated buffer objects */
 
+/**
+ *  Buffer sequence lock (neighbour buffers may be destroyed by other
+ *  threads); it guards the sequence links and chained positions.
+ *  Newlines are never counted while the lock is held.
+ */
+static pthread_mutex_t buffer_link_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signalled when newline counting pins are released or a buffer is unlinked */
+static pthread_cond_t buffer_link_cond = PTHREAD_COND_INITIALIZER;
+
+
+static void buffer_resolve_chained_position(buffer_t *buffer);
+
+static buffer_t *buffer_resolve_position(buffer_t *buffer);
+
+static void buffer_count_newlines(buffer_t *buffer, int owned);
+
+inline static int buffer_nl_counted(buffer_t *buffer);
+
+inline static void buffer_end_position__counted(const buffer_t *buffer, size_t *line, size_t *column);
+
+static void buffer_end_position__impl(const buffer_t *buffer, size_t *line, size_t *column);
 
-/** Buffer object pool */
-static objpool_t buffer_pool = OBJPOOL_INIT(sizeof(buffer_t), BUFFER_RESERVE_MAX);
+static size_t buffer_scan_newlines(const char *data, size_t size, size_t *index);
 
+inline static const char *buffer_last_newline(const char *data, size_t size);
 
-static void init(void)     __attribute__((constructor));
-static void finalise(void) __attribute__((destructor));
 
 
 buffer_t *buffer_create(char *data, size_t size, buffer_cleanup_fn *cleanup_fn, void *user_obj, int is_last) {
     assert(0 == size || NULL != data);
 
-    buffer_t *buffer = (buffer_t *)objpool_alloc(&buffer_pool);
+    buffer_t *buffer = (buffer_t *)malloc(sizeof(buffer_t));
 
     if (NULL == buffer) return NULL;
 
@@ -69,6 +95,17 @@ buffer_t *buffer_create(char *data, size_t size, buffer_cleanup_fn *cleanup_fn,
     /* When created, the buffer stands alone */
     buffer->prev = buffer->next = NULL;
 
+    /* Source position is unknown */
+    buffer->line        = 0;
+    buffer->column      = 0;
+    buffer->pos_chained = 0;
+    buffer->nl_counted  = 0;
+    buffer->nl_cnt      = 0;
+    buffer->nl_tail     = 0;
+    buffer->pins        = 0;
+    buffer->dying       = 0;
+    buffer->nl_index    = NULL;
+
     return buffer;
 }
 
@@ -76,39 +113,396 @@ buffer_t *buffer_create(char *data, size_t size, buffer_cleanup_fn *cleanup_fn,
 void buffer_destroy(buffer_t *buffer) {
     assert(NULL != buffer);
 
+    /* Neighbours may be destroyed by other threads concurrently */
+    pthread_mutex_lock(&buffer_link_mutex);
+
+    /* Wait for other threads counting the buffer newlines */
+    buffer->dying = 1;
+
+    while (buffer->pins)
+        pthread_cond_wait(&buffer_link_cond, &buffer_link_mutex);
+
+    /* Hand chained position over to the next buffer (data are leaving) */
+    for (;;) {
+        buffer_t *next = buffer->next;
+
+        if (NULL == next) break;
+
+        buffer_t *uncounted = buffer_resolve_position(next);
+
+        if (NULL == uncounted) break;
+
+        buffer_count_newlines(uncounted, uncounted == buffer);
+    }
+
     /* Remove buffer from sequence */
     if (NULL != buffer->prev)
         buffer->prev->next = NULL;
     if (NULL != buffer->next)
         buffer->next->prev = NULL;
 
+    pthread_cond_broadcast(&buffer_link_cond);
+
+    pthread_mutex_unlock(&buffer_link_mutex);
+
     if (NULL != buffer->cleanup_fn)
         buffer->cleanup_fn(buffer->user_obj, buffer->data, buffer->size);
 
-    objpool_free(&buffer_pool, buffer);
+    free(buffer->nl_index);
+
+    free(buffer);
+}
+
+
+void buffer_position(buffer_t *buffer, size_t offset, size_t *line, size_t *column) {
+    assert(NULL != buffer);
+    assert(offset <= buffer->size);
+    assert(NULL != line);
+    assert(NULL != column);
+
+    /* Resolve chained position */
+    if (!__atomic_load_n(&buffer->line, __ATOMIC_ACQUIRE))
+        buffer_resolve_chained_position(buffer);
+
+    assert(0 < buffer->line);
+
+    /* Newline index (count and offsets); built once */
+    size_t *nl_index = __atomic_load_n(&buffer->nl_index, __ATOMIC_ACQUIRE);
+
+    if (NULL == nl_index) {
+        size_t nl_cnt = buffer_scan_newlines(buffer->data, buffer->size, NULL);
+
+        nl_index = (size_t *)malloc((1 + nl_cnt) * sizeof(size_t));
+
+        /* Index unavailable, count newlines directly */
+        if (NULL == nl_index) {
+            size_t lines_before = buffer_scan_newlines(buffer->data, offset, NULL);
+
+            const char *nl = buffer_last_newline(buffer->data, offset);
+
+            *line   = buffer->line + lines_before;
+            *column = NULL != nl
+                    ? (size_t)(buffer->data + offset - nl)
+                    : buffer->column + offset;
+
+            return;
+        }
+
+        nl_index[0] = buffer_scan_newlines(buffer->data, buffer->size, nl_index + 1);
+
+        /* Publish the index (unless another thread has been faster) */
+        size_t *published = NULL;
+
+        if (!__atomic_compare_exchange_n(&buffer->nl_index, &published, nl_index,
+                0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            free(nl_index);
+
+            nl_index = published;
+        }
+    }
+
+    const size_t *nl_offs = nl_index + 1;
+
+    /* Count newlines before the offset (binary search) */
+    size_t lo = 0;
+    size_t hi = nl_index[0];
+
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+
+        if (nl_offs[mid] < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    *line   = buffer->line + lo;
+    *column = lo
+            ? offset - nl_offs[lo - 1]
+            : buffer->column + offset;
+}
+
+
+void buffer_end_position(buffer_t *buffer, size_t *line, size_t *column) {
+    assert(NULL != buffer);
+    assert(NULL != line);
+    assert(NULL != column);
+
+    /* Resolve chained position */
+    if (!__atomic_load_n(&buffer->line, __ATOMIC_ACQUIRE))
+        buffer_resolve_chained_position(buffer);
+
+    buffer_end_position__impl(buffer, line, column);
+}
+
+
+/**
+ *  \brief  Resolve chained buffer position (unless known)
+ *
+ *  The function resolves the position under the buffer sequence lock;
+ *  newlines of the preceding buffers are counted outside of it.
+ *
+ *  \param  buffer  Buffer
+ */
+static void buffer_resolve_chained_position(buffer_t *buffer) {
+    pthread_mutex_lock(&buffer_link_mutex);
+
+    buffer_t *uncounted;
+
+    while (NULL != (uncounted = buffer_resolve_position(buffer)))
+        buffer_count_newlines(uncounted, 0);
+
+    pthread_mutex_unlock(&buffer_link_mutex);
+}
+
+
+/**
+ *  \brief  Resolve chained buffer position (step)
+ *
+ *  The function walks back over the buffers with chained unknown
+ *  positions and resolves them forth (see \ref buffer_chain_position).
+ *  It does nothing if the buffer position isn't chained or known.
+ *  If newlines of some of the preceding buffers (or of the buffer
+ *  with known position just before them) haven't been counted, yet,
+ *  the function resolves nothing and returns the 1st such buffer
+ *  (see \ref buffer_count_newlines).
+ *  The buffer sequence lock must be held.
+ *
+ *  \param  buffer  Buffer
+ *
+ *  \return \c NULL or buffer which newlines must be counted, first
+ */
+static buffer_t *buffer_resolve_position(buffer_t *buffer) {
+    if (buffer->line || !buffer->pos_chained) return NULL;
+
+    /* Find the 1st buffer with unknown position */
+    buffer_t *first = buffer;
+
+    while (NULL != first->prev && 0 == first->prev->line && first->prev->pos_chained)
+        first = first->prev;
+
+    buffer_t *prev = first->prev;
+
+    /* Position of the previous buffer is unknown */
+    if (NULL != prev && 0 == prev->line) return NULL;
+
+    /* Newlines of the preceding buffers must be counted */
+    for (buffer_t *b = NULL != prev ? prev : first; b != buffer; b = b->next)
+        if (!buffer_nl_counted(b)) return b;
+
+    size_t line   = 1;
+    size_t column = 1;
+
+    if (NULL != prev)
+        buffer_end_position__counted(prev, &line, &column);
+
+    /* Resolve positions forth (line is the resolution flag) */
+    for (;;) {
+        first->column = column;
+
+        __atomic_store_n(&first->line, line, __ATOMIC_RELEASE);
+
+        if (first == buffer) break;
+
+        buffer_end_position__counted(first, &line, &column);
+
+        first = first->next;
+    }
+
+    return NULL;
+}
+
+
+/**
+ *  \brief  Count buffer newlines
+ *
+ *  The function counts the buffer newlines (and characters after
+ *  the last one) with the buffer sequence lock released.
+ *  Unless owned by the caller (i.e. being destroyed by it),
+ *  the buffer is pinned meanwhile, so that it isn't destroyed;
+ *  if it's being destroyed already, the function only waits until
+ *  the buffer is unlinked and nothing is counted.
+ *  The buffer sequence lock must be held; it's re-acquired before
+ *  the function returns, but the buffer sequence may have changed.
+ *
+ *  \param  buffer  Buffer
+ *  \param  owned   Buffer is being destroyed by the caller
+ */
+static void buffer_count_newlines(buffer_t *buffer, int owned) {
+    if (!owned) {
+        if (buffer->dying) {
+            pthread_cond_wait(&buffer_link_cond, &buffer_link_mutex);
+
+            return;
+        }
+
+        ++buffer->pins;
+    }
+
+    pthread_mutex_unlock(&buffer_link_mutex);
+
+    size_t cnt = buffer_scan_newlines(buffer->data, buffer->size, NULL);
+
+    const char *nl = cnt ? buffer_last_newline(buffer->data, buffer->size) : NULL;
+
+    size_t tail = NULL != nl
+                ? (size_t)(buffer->data + buffer->size - nl) - 1
+                : buffer->size;
+
+    pthread_mutex_lock(&buffer_link_mutex);
+
+    buffer->nl_cnt     = cnt;
+    buffer->nl_tail    = tail;
+    buffer->nl_counted = 1;
+
+    if (!owned && 0 == --buffer->pins && buffer->dying)
+        pthread_cond_broadcast(&buffer_link_cond);
+}
+
+
+/**
+ *  \brief  Check whether buffer newlines are counted
+ *
+ *  The count is also taken from the newline index if it's been built.
+ *  The buffer sequence lock must be held.
+ *
+ *  \param  buffer  Buffer
+ *
+ *  \return Non-zero iff the buffer newlines are counted
+ */
+inline static int buffer_nl_counted(buffer_t *buffer) {
+    if (buffer->nl_counted) return 1;
+
+    const size_t *nl_index = __atomic_load_n(&buffer->nl_index, __ATOMIC_ACQUIRE);
+
+    if (NULL == nl_index) return 0;
+
+    size_t cnt = nl_index[0];
+
+    buffer->nl_cnt     = cnt;
+    buffer->nl_tail    = cnt ? buffer->size - nl_index[cnt] - 1 : buffer->size;
+    buffer->nl_counted = 1;
+
+    return 1;
+}
+
+
+/**
+ *  \brief  Resolve source position just after buffer data (counted newlines)
+ *
+ *  The buffer position must be known and its newlines counted.
+ *
+ *  \param  buffer  Buffer
+ *  \param  line    Line   number (output)
+ *  \param  column  Column number (output)
+ */
+inline static void buffer_end_position__counted(const buffer_t *buffer, size_t *line, size_t *column) {
+    assert(0 < buffer->line);
+    assert(buffer->nl_counted);
+
+    *line   = buffer->line + buffer->nl_cnt;
+    *column = buffer->nl_cnt
+            ? buffer->nl_tail + 1
+            : buffer->column + buffer->nl_tail;
 }
 
 
 /**
- *  \brief  Module constructor (GCC only!)
+ *  \brief  Resolve source position just after buffer data (known position)
  *
- *  If compiled with gcc, this shall be executed before \c main
- *  routine is called.
- *  Preallocates a few buffer object in the pool in advance
- *  to speed-up initial buffer provision.
+ *  \param  buffer  Buffer
+ *  \param  line    Line   number (output)
+ *  \param  column  Column number (output)
  */
-static void init(void) {
-    objpool_prealloc(&buffer_pool, BUFFER_PREALLOC);
+static void buffer_end_position__impl(const buffer_t *buffer, size_t *line, size_t *column) {
+    assert(0 < buffer->line);
+
+    const size_t *nl_index = __atomic_load_n(&buffer->nl_index, __ATOMIC_ACQUIRE);
+
+    size_t nl_cnt = NULL != nl_index
+                  ? nl_index[0]
+                  : buffer_scan_newlines(buffer->data, buffer->size, NULL);
+
+    *line = buffer->line + nl_cnt;
+
+    if (0 == nl_cnt) {
+        *column = buffer->column + buffer->size;
+
+        return;
+    }
+
+    const char *nl = buffer_last_newline(buffer->data, buffer->size);
+
+    assert(NULL != nl);
+
+    *column = (size_t)(buffer->data + buffer->size - nl);
 }
 
 
 /**
- *  \brief  Module destructor (GCC only!)
+ *  \brief  Scan data for newlines
  *
- *  If compiled with gcc this shall be executed after \c main
- *  routine scope is left.
- *  Cleans the buffer pool up.
+ *  The function counts newlines in the data and optionally
+ *  stores their offsets to the index.
+ *  The index must be large enough.
+ *  SSE2 is used if available.
+ *
+ *  \param  data   Data
+ *  \param  size   Data size
+ *  \param  index  Newline offsets index (optional)
+ *
+ *  \return Newline count
  */
-static void finalise(void) {
-    objpool_finalise(&buffer_pool);
+static size_t buffer_scan_newlines(const char *data, size_t size, size_t *index) {
+    assert(0 == size || NULL != data);
+
+    size_t cnt = 0;
+    size_t off = 0;
+
+#ifdef __SSE2__
+    const __m128i nl = _mm_set1_epi8('\n');
+
+    for (; off + 16 <= size; off += 16) {
+        __m128i  chunk = _mm_loadu_si128((const __m128i *)(data + off));
+        unsigned mask  = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, nl));
+
+        if (NULL == index) {
+            cnt += __builtin_popcount(mask);
+
+            continue;
+        }
+
+        for (; mask; mask &= mask - 1)
+            index[cnt++] = off + __builtin_ctz(mask);
+    }
+#endif  /* end of #ifdef __SSE2__ */
+
+    for (; off < size; ++off) {
+        if ('\n' != data[off]) continue;
+
+        if (NULL != index)
+            index[cnt] = off;
+
+        ++cnt;
+    }
+
+    return cnt;
 }
+
+
+/**
+ *  \brief  Find last newline in data
+ *
+ *  \param  data  Data
+ *  \param  size  Data size
+ *
+ *  \return Last newline in the data or \c NULL if there's none
+ */
+inline static const char *buffer_last_newline(const char *data, size_t size) {
+    while (size--)
+        if ('\n' == data[size]) return data + size;
+
+    return NULL;
+}
+
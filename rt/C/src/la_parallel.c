@@ -0,0 +1,474 @@
+/**
+ *  \brief  Parallel lexical analysis: definitions
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "la_parallel.h"
+#include "lexical_analyser.h"
+#include "fsa.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+
+
+#define LA_TOKENS_CAPACITY_MIN 64  /**< Initial token stream capacity */
+
+
+typedef struct la_parallel la_parallel_t;  /**< Parallel tokenization context */
+typedef struct la_chunk    la_chunk_t;     /**< Source chunk                  */
+
+
+/** Parallel tokenization context */
+struct la_parallel {
+    const fsa_t *fsa;          /**< Lexical items language FSA       */
+    fsa_t        lex_fsa;      /**< The FSA without skipped items    */
+    size_t       items_total;  /**< Item set cardinality             */
+    const char  *data;         /**< Source                           */
+    size_t       size;         /**< Source size                      */
+};  /* end of struct la_parallel */
+
+
+/** Source chunk */
+struct la_chunk {
+    const la_parallel_t *par;       /**< Tokenization context                */
+    size_t               begin;     /**< Chunk begin offset                  */
+    size_t               end;       /**< Chunk end offset                    */
+    la_tokens_t          tokens;    /**< Speculative token stream            */
+    la_status_t          status;    /**< Speculative tokenization status     */
+    pthread_t            thread;    /**< Tokenizing thread                   */
+    int                  threaded;  /**< Non-zero if the thread was created  */
+};  /* end of struct la_chunk */
+
+
+/*
+ * Static routines forward declarations
+ */
+
+inline static int la_tokens__reserve(la_tokens_t *tokens, size_t cnt);
+
+inline static int la_tokens__push(la_tokens_t *tokens, int code, size_t offset, size_t length);
+
+inline static size_t la_tokens__find(const la_tokens_t *tokens, size_t offset);
+
+inline static int la_parallel__skipped(const fsa_t *fsa, int code);
+
+static la_status_t la_parallel__lex(const la_parallel_t *par, size_t begin, size_t end,
+                                    const la_chunk_t *spec, la_tokens_t *tokens);
+
+static void *la_parallel__worker(void *chunk);
+
+
+/*
+ * Module interface implementation
+ */
+
+la_tokens_t *la_tokens_create(la_tokens_t *tokens) {
+    assert(NULL != tokens);
+
+    memset(tokens, 0, sizeof(la_tokens_t));
+
+    return tokens;
+}
+
+
+void la_tokens_destroy(la_tokens_t *tokens) {
+    assert(NULL != tokens);
+
+    free(tokens->codes);
+    free(tokens->offsets);
+    free(tokens->lengths);
+
+    memset(tokens, 0, sizeof(la_tokens_t));
+}
+
+
+la_status_t la_tokenize_parallel(const fsa_t *fsa, size_t items_total,
+                                 const char *data, size_t size, size_t thread_cnt,
+                                 la_tokens_t *tokens)
+{
+    assert(NULL != fsa);
+    assert(NULL != data || 0 == size);
+    assert(NULL != tokens);
+
+    /*
+     * Skipped items are resolved here, the chunk streams keep them;
+     * convergence is only detected at positions where an item
+     * (skipped or not) begins
+     */
+    la_parallel_t par = {
+        .fsa         = fsa,
+        .lex_fsa     = fsa_with_skips(fsa, 0, NULL),
+        .items_total = items_total,
+        .data        = data,
+        .size        = size,
+    };
+
+    /* Chunk count (chunks are never empty) */
+    size_t chunk_cnt = thread_cnt < size ? thread_cnt : size;
+
+    if (0 == chunk_cnt)
+        chunk_cnt = 1;
+
+    la_chunk_t *chunks = (la_chunk_t *)calloc(chunk_cnt, sizeof(la_chunk_t));
+
+    if (NULL == chunks) return LA_ERROR;
+
+    size_t i;
+
+    for (i = 0; i < chunk_cnt; ++i) {
+        la_chunk_t *chunk = chunks + i;
+
+        chunk->par   = &par;
+        chunk->begin = size / chunk_cnt * i + size % chunk_cnt * i / chunk_cnt;
+        chunk->end   = i + 1 < chunk_cnt
+                     ? size / chunk_cnt * (i + 1) + size % chunk_cnt * (i + 1) / chunk_cnt
+                     : SIZE_MAX;  /* the last chunk is lexed up to EoF */
+
+        la_tokens_create(&chunk->tokens);
+    }
+
+    /* Lex chunks speculatively (the 1st one in this thread) */
+    for (i = 1; i < chunk_cnt; ++i) {
+        la_chunk_t *chunk = chunks + i;
+
+        chunk->threaded = !pthread_create(&chunk->thread, NULL, la_parallel__worker, chunk);
+
+        /* Thread creation failure isn't fatal, the chunk is re-lexed */
+        if (!chunk->threaded)
+            chunk->status = LA_ERROR;
+    }
+
+    la_parallel__worker(chunks);
+
+    for (i = 1; i < chunk_cnt; ++i)
+        if (chunks[i].threaded)
+            pthread_join(chunks[i].thread, NULL);
+
+    /* Stitch chunk token streams */
+    size_t      first  = tokens->cnt;
+    size_t      pos    = 0;
+    la_status_t status = LA_OK;
+
+    for (i = 0; i < chunk_cnt && LA_OK == status; ++i) {
+        la_chunk_t *chunk = chunks + i;
+
+        /* The chunk is covered by the previous chunk last token */
+        if (pos >= chunk->end) continue;
+
+        const la_chunk_t *spec = LA_ERROR != chunk->status ? chunk : NULL;
+
+        status = la_parallel__lex(&par, pos, chunk->end, spec, tokens);
+
+        if (tokens->cnt > first)
+            pos = tokens->offsets[tokens->cnt - 1] + tokens->lengths[tokens->cnt - 1];
+    }
+
+    for (i = 0; i < chunk_cnt; ++i)
+        la_tokens_destroy(&chunks[i].tokens);
+
+    free(chunks);
+
+    /* Discard skipped items */
+    if (fsa_skip_cnt(fsa)) {
+        size_t j = first;
+
+        for (i = first; i < tokens->cnt; ++i) {
+            if (la_parallel__skipped(fsa, tokens->codes[i])) continue;
+
+            tokens->codes[j]   = tokens->codes[i];
+            tokens->offsets[j] = tokens->offsets[i];
+            tokens->lengths[j] = tokens->lengths[i];
+
+            ++j;
+        }
+
+        tokens->cnt = j;
+    }
+
+    /* End of file */
+    if (LA_OK == status && la_tokens__push(tokens, LEXIG_EOF, size, 0))
+        status = LA_ERROR;
+
+    return status;
+}
+
+
+/*
+ * Static routines definitions
+ */
+
+/**
+ *  \brief  Make space for more tokens in token stream
+ *
+ *  \param  tokens  Token stream
+ *  \param  cnt     Number of tokens to be added
+ *
+ *  \retval 0      on success
+ *  \retval ENOMEM on memory allocation failure
+ */
+inline static int la_tokens__reserve(la_tokens_t *tokens, size_t cnt) {
+    assert(NULL != tokens);
+
+    if (tokens->cnt + cnt <= tokens->capacity) return 0;
+
+    size_t capacity = tokens->capacity ? 2 * tokens->capacity : LA_TOKENS_CAPACITY_MIN;
+
+    while (capacity < tokens->cnt + cnt)
+        capacity *= 2;
+
+    /* Capacity is only updated when all the arrays are reallocated */
+    int *codes = (int *)realloc(tokens->codes, capacity * sizeof(int));
+
+    if (NULL == codes) return ENOMEM;
+
+    tokens->codes = codes;
+
+    size_t *offsets = (size_t *)realloc(tokens->offsets, capacity * sizeof(size_t));
+
+    if (NULL == offsets) return ENOMEM;
+
+    tokens->offsets = offsets;
+
+    size_t *lengths = (size_t *)realloc(tokens->lengths, capacity * sizeof(size_t));
+
+    if (NULL == lengths) return ENOMEM;
+
+    tokens->lengths  = lengths;
+    tokens->capacity = capacity;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Append token to token stream
+ *
+ *  \param  tokens  Token stream
+ *  \param  code    Item code
+ *  \param  offset  Token offset
+ *  \param  length  Token length
+ *
+ *  \retval 0      on success
+ *  \retval ENOMEM on memory allocation failure
+ */
+inline static int la_tokens__push(la_tokens_t *tokens, int code, size_t offset, size_t length) {
+    int status = la_tokens__reserve(tokens, 1);
+
+    if (status) return status;
+
+    size_t idx = tokens->cnt++;
+
+    tokens->codes[idx]   = code;
+    tokens->offsets[idx] = offset;
+    tokens->lengths[idx] = length;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Find token by offset
+ *
+ *  Token offsets are increasing, so binary search is used.
+ *
+ *  \param  tokens  Token stream
+ *  \param  offset  Token offset
+ *
+ *  \return Token index or tokens count if there's no token at the offset
+ */
+inline static size_t la_tokens__find(const la_tokens_t *tokens, size_t offset) {
+    assert(NULL != tokens);
+
+    size_t lo = 0;
+    size_t hi = tokens->cnt;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (tokens->offsets[mid] < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo < tokens->cnt && tokens->offsets[lo] == offset ? lo : tokens->cnt;
+}
+
+
+/**
+ *  \brief  Check whether lexical item is skipped
+ *
+ *  \param  fsa   Lexical items language FSA
+ *  \param  code  Lexical item code
+ *
+ *  \return Non-zero iff the item is skipped
+ */
+inline static int la_parallel__skipped(const fsa_t *fsa, int code) {
+    size_t skip_cnt = fsa_skip_cnt(fsa);
+    size_t i        = 0;
+
+    for (; i < skip_cnt; ++i)
+        if ((int)fsa_skips(fsa)[i] == code) return 1;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Tokenize source part
+ *
+ *  The source is tokenized from \c begin (a token is expected there)
+ *  until a token beginning at or after \c end is found or EoF is reached
+ *  (neither is added to the stream).
+ *  Skipped items are kept in the stream.
+ *
+ *  If speculatively tokenized chunk is provided, the function checks
+ *  each token offset against its token stream.
+ *  As soon as the offset is found there, the streams converged;
+ *  the rest of the speculative stream is appended and the chunk
+ *  tokenization status is returned.
+ *  The chunk must've been tokenized up to the same end offset.
+ *
+ *  \param  par     Tokenization context
+ *  \param  begin   Begin offset
+ *  \param  end     End offset
+ *  \param  spec    Speculatively tokenized chunk (or \c NULL)
+ *  \param  tokens  Token stream
+ *
+ *  \retval LA_OK            if the part was tokenized
+ *  \retval LA_INPUT_INVALID if unexpected sequence was found
+ *  \retval LA_ERROR         on memory allocation failure
+ */
+static la_status_t la_parallel__lex(const la_parallel_t *par, size_t begin, size_t end,
+                                    const la_chunk_t *spec, la_tokens_t *tokens)
+{
+    assert(NULL != par);
+    assert(begin <= par->size);
+    assert(NULL != tokens);
+
+    lexa_t la;
+
+    if (NULL == la_create(&la, &par->lex_fsa, par->items_total))
+        return LA_ERROR;
+
+    la_set_pos_mode(&la, LA_POS_OFFSET);
+
+    la_status_t status = la_add_data(&la, (char *)par->data + begin, par->size - begin,
+                                     NULL, NULL, 1);
+
+    while (LA_OK == status) {
+        const la_item_t *items;
+        size_t           item_cnt;
+
+        status = la_get_items(&la, &items, &item_cnt);
+
+        if (LA_OK != status) break;
+
+        assert(0 < item_cnt);
+
+        /* Choose the longest item (preferring skipped one) */
+        const la_item_t *item = items;
+
+        size_t i = 1;
+
+        for (; i < item_cnt; ++i) {
+            if (items[i].length > item->length)
+                item = items + i;
+
+            else if (items[i].length == item->length &&
+                     !la_parallel__skipped(par->fsa, item->code) &&
+                     la_parallel__skipped(par->fsa, items[i].code))
+            {
+                item = items + i;
+            }
+        }
+
+        size_t offset = begin + item->offset;
+
+        /* Part end reached */
+        if (LEXIG_EOF == item->code || offset >= end) break;
+
+        /* Convergence with the speculative stream */
+        if (NULL != spec) {
+            const la_tokens_t *spec_tokens = &spec->tokens;
+
+            size_t idx = la_tokens__find(spec_tokens, offset);
+
+            if (idx < spec_tokens->cnt) {
+                size_t cnt = spec_tokens->cnt - idx;
+
+                if (la_tokens__reserve(tokens, cnt)) {
+                    status = LA_ERROR;
+
+                    break;
+                }
+
+                memcpy(tokens->codes   + tokens->cnt, spec_tokens->codes   + idx, cnt * sizeof(int));
+                memcpy(tokens->offsets + tokens->cnt, spec_tokens->offsets + idx, cnt * sizeof(size_t));
+                memcpy(tokens->lengths + tokens->cnt, spec_tokens->lengths + idx, cnt * sizeof(size_t));
+
+                tokens->cnt += cnt;
+
+                la_destroy(&la);
+
+                return spec->status;
+            }
+        }
+
+        if (la_tokens__push(tokens, item->code, offset, item->length)) {
+            status = LA_ERROR;
+
+            break;
+        }
+
+        status = la_read_item(&la, item->code);
+    }
+
+    la_destroy(&la);
+
+    return LA_ERROR == status || LA_INPUT_INVALID == status ? status : LA_OK;
+}
+
+
+/**
+ *  \brief  Chunk tokenizing thread routine
+ *
+ *  \param  chunk  Source chunk
+ *
+ *  \return \c NULL
+ */
+static void *la_parallel__worker(void *chunk) {
+    la_chunk_t *ch = (la_chunk_t *)chunk;
+
+    assert(NULL != ch);
+
+    ch->status = la_parallel__lex(ch->par, ch->begin, ch->end, NULL, &ch->tokens);
+
+    return NULL;
+}
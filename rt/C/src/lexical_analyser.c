@@ -29,9 +29,23 @@
 #include "buffer.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+#define LA_MEMO_CAPACITY_MIN 64  /**< Initial failed scans memo capacity */
+
+/** Failed scans memo hash (Fibonacci hashing of the position) */
+#define LA_MEMO_HASH(state, pos) \
+    (((size_t)(pos) * (size_t)0x9e3779b97f4a7c15ULL) ^ ((size_t)(uintptr_t)(state) >> 4))
+
 
 /*
  * Static routines forward declarations
@@ -39,9 +53,31 @@
 
 static la_status_t la_get_item__impl(lexa_t *la);
 
+static la_status_t la_get_item__segment(lexa_t *la);
+
+inline static int la_get_item__skipped(const lexa_t *la);
+
+inline static size_t la_item_index(const lexa_t *la, int code);
+
 inline static void la_get_item__add_state_accepts(lexa_t *la);
 
-inline static const fsa_state_t *la_get_item__follow_branch(lexa_t *la);
+inline static const fsa_state_t *la_get_item__branch_target(const fsa_t *fsa, const fsa_state_t *state, char ch);
+
+inline static size_t la_get_item__skip_loop(const fsa_loop_t *loop, const char *data, size_t size);
+
+inline static const fsa_state_t *la_get_item__scan(lexa_t *la);
+
+static void la_get_item__memo_overrun(lexa_t *la);
+
+inline static int la_fsa_skips(const fsa_t *fsa, int code);
+
+static void la_tokenize_batch__buffer(lexa_t *la, la_batch_t *batch);
+
+inline static int la_memo__find(const la_memo_t *memo, const fsa_state_t *state, size_t pos);
+
+inline static void la_memo__insert(la_memo_t *memo, const fsa_state_t *state, size_t pos);
+
+inline static void la_memo__clear(la_memo_t *memo);
 
 static void la_free_token(void *null, char *data, size_t length);
 
@@ -89,6 +125,22 @@ lexa_t *la_create(lexa_t *la, const fsa_t *fsa, size_t items_total) {
 }
 
 
+void la_set_pos_mode(lexa_t *la, la_pos_mode_t mode) {
+    assert(NULL != la);
+    assert(NULL == la->buff_last);
+
+    la->pos_mode = mode;
+
+    /* Lines and columns are unknown in offset-only mode */
+    size_t pos = LA_POS_OFFSET == mode ? 0 : 1;
+
+    la->state.token_line   = pos;
+    la->state.token_column = pos;
+    la->state.line         = pos;
+    la->state.column       = pos;
+}
+
+
 void la_destroy(lexa_t *la) {
     assert(NULL != la);
 
@@ -105,6 +157,8 @@ void la_destroy(lexa_t *la) {
 
     free(la->state.item_pos);
     free(la->state.item_list);
+
+    la_memo__clear(&la->state.memo);
 }
 
 
@@ -129,6 +183,10 @@ void la_add_buffer(lexa_t *la, buffer_t *buffer) {
 
     buffer_ref(buffer);
 
+    /* Chain buffer source position (offset-only tracking, resolved lazily) */
+    if (LA_POS_OFFSET == la->pos_mode && 0 == buffer_line(buffer))
+        buffer_chain_position(buffer);
+
     if (la->buff_last) {
         buffer_set_next(la->buff_last, buffer);
         buffer_set_prev(buffer, la->buff_last);
@@ -164,11 +222,11 @@ const la_item_t *la_get_item(lexa_t *la, int item_code) {
 
     la_get_item__impl(la);
 
-    size_t item_idx = la->state.item_pos[item_code];
+    size_t item_idx = la_item_index(la, item_code);
 
     la_item_t *item = NULL;
 
-    if (item_idx < la->items_total) {
+    if (item_idx < la->state.item_cnt) {
         item = la->state.item_list + item_idx;
 
         assert(item->code == item_code);
@@ -183,7 +241,7 @@ la_status_t la_read_item(lexa_t *la, int item_code) {
     assert(0 <= item_code && item_code <= la->items_total);
 
     /* Get item position */
-    size_t item_idx = la->state.item_pos[item_code];
+    size_t item_idx = la_item_index(la, item_code);
 
     if (!(item_idx < la->state.item_cnt)) return LA_ERROR;
 
@@ -193,42 +251,30 @@ la_status_t la_read_item(lexa_t *la, int item_code) {
     /* Reading from end of file doesn't make sense, either */
     assert(LEXIG_EOF != la->state.item_list[0].code);
 
+    const la_item_t *item = la->state.item_list + item_idx;
+
     /* Set next token source offset */
-    la->state.token_offset += la->state.item_list[item_idx].length;
+    la->state.token_offset += item->length;
 
     /* Set source file position */
-    la->state.line = la->state.token_line =
-        la->state.item_list[item_idx].next_line;
-    la->state.column = la->state.token_column =
-        la->state.item_list[item_idx].next_column;
-
-    /* Compensate for potential lexical item overrun */
-    la->state.token_length -= la->state.item_list[item_idx].length;
-
-    if (NULL == la->buffer) {
-        la->buffer = la->buff_last;
-        la->state.buffer_offset = buffer_size(la->buffer);
-    }
-
-    while (0 < la->state.token_length) {
-        size_t buffer_diff = la->state.token_length;
+    la->state.line   = la->state.token_line   = item->next_line;
+    la->state.column = la->state.token_column = item->next_column;
 
-        /* Go one buffer backwards if token spans over multiple buffers */
-        if (buffer_diff > la->state.buffer_offset) {
-            buffer_diff = la->state.buffer_offset;
+    /* Resume at the item last-accept checkpoint (skip overrun) */
+    la->buffer              = item->next_buff;
+    la->state.buffer_offset = item->next_off;
+    la->state.token_length  = 0;
 
-            la->buffer = la->buffer->prev;
-            la->state.buffer_offset = buffer_size(la->buffer);
-        }
-        else {
-            la->state.buffer_offset -= buffer_diff;
-        }
+    assert(NULL != la->buffer);
 
-        la->state.token_length -= buffer_diff;
+    /* Checkpoint at buffer end, move to the next one (if available) */
+    if (buffer_size(la->buffer) == la->state.buffer_offset &&
+        NULL != buffer_get_next(la->buffer))
+    {
+        la->buffer = buffer_get_next(la->buffer);
+        la->state.buffer_offset = 0;
     }
 
-    la->state.token_length = 0;
-
     /* Unreference all used-up buffers */
     while (la->state.token_buff != la->buffer) {
         assert(NULL != la->state.token_buff);
@@ -242,19 +288,8 @@ la_status_t la_read_item(lexa_t *la, int item_code) {
 
     la->state.token_buff_off = la->state.buffer_offset;
 
-    /* Reset listed items and their positions (list is non-empty) */
-    do {
-        --la->state.item_cnt;
-
-        la_item_t *item = &la->state.item_list[la->state.item_cnt];
-
-        la->state.item_pos[item->code] = la->items_total;
-
-#ifndef NDEBUG
-        memset(item, 0, sizeof(*item));
-#endif  /* end of #ifndef NDEBUG */
-
-    } while (0 < la->state.item_cnt);
+    /* Reset listed items (their positions are invalidated, too) */
+    la->state.item_cnt = 0;
 
     /* Make the analyser ready for further segmentation */
     la->state.fsa_state = fsa_root(la->fsa);
@@ -264,6 +299,58 @@ la_status_t la_read_item(lexa_t *la, int item_code) {
 }
 
 
+la_status_t la_tokenize_batch(lexa_t *la, la_batch_t *batch) {
+    assert(NULL != la);
+    assert(NULL != batch);
+    assert(batch->cnt <= batch->capacity);
+
+    while (batch->cnt < batch->capacity) {
+        /* Tight loop over the current buffer */
+        la_tokenize_batch__buffer(la, batch);
+
+        if (!(batch->cnt < batch->capacity)) break;
+
+        /* General segmentation (of a token the tight loop left) */
+        la_status_t status = la_get_item__impl(la);
+
+        if (LA_OK != status) return status;
+
+        assert(0 < la->state.item_cnt);
+
+        /* Choose the longest item */
+        const la_item_t *item = la->state.item_list;
+
+        size_t i = 1;
+
+        for (; i < la->state.item_cnt; ++i)
+            if (la->state.item_list[i].length > item->length)
+                item = la->state.item_list + i;
+
+        /* Append token */
+        size_t idx = batch->cnt++;
+
+        batch->codes[idx]   = item->code;
+        batch->offsets[idx] = item->offset;
+        batch->lengths[idx] = item->length;
+
+        if (NULL != batch->lines)
+            batch->lines[idx] = LEXIG_EOF == item->code
+                              ? item->line : la_item_token_line(item);
+
+        if (NULL != batch->columns)
+            batch->columns[idx] = LEXIG_EOF == item->code
+                                ? item->column : la_item_token_column(item);
+
+        /* End of file */
+        if (LEXIG_EOF == item->code) break;
+
+        la_read_item(la, item->code);
+    }
+
+    return LA_OK;
+}
+
+
 const char *la_item_token(la_item_t *item, size_t *length) {
     assert(NULL != item);
     assert(NULL != length);
@@ -271,22 +358,36 @@ const char *la_item_token(la_item_t *item, size_t *length) {
     *length = item->length;
 
     buffer_t *buffer = item->buff_1st;
-    size_t    offset = item->buff_off;
-    size_t    size   = buffer_size(buffer) - offset;
+
+    /* Token is stored inline (or empty) */
+    if (NULL == buffer)
+        return item->token;
+
+    size_t offset = item->buff_off;
+    size_t size   = buffer_size(buffer) - offset;
 
     /* Token isn't fragmented */
     if (*length <= size)
         return buffer_data(buffer) + offset;
 
-    /* Create new buffer for token copy */
-    char *data = (char *)malloc(*length * sizeof(char));
-    if (NULL == data)
-        return NULL;
+    /* The token buffers are about to be replaced, resolve position */
+    la_item_resolve_position(item);
 
-    buffer_t *new_buffer = buffer_create(data, *length, &la_free_token, NULL, 1);
-    if (NULL == new_buffer) {
-        free(data);
-        return NULL;
+    /* Short token is concatenated inline, long one in new buffer */
+    int       is_inline  = *length <= LA_ITEM_INLINE_SIZE;
+    char     *data       = item->token;
+    buffer_t *new_buffer = NULL;
+
+    if (!is_inline) {
+        data = (char *)malloc(*length * sizeof(char));
+        if (NULL == data)
+            return NULL;
+
+        new_buffer = buffer_create(data, *length, &la_free_token, NULL, 1);
+        if (NULL == new_buffer) {
+            free(data);
+            return NULL;
+        }
     }
 
     /* Concatenate buffers */
@@ -313,11 +414,12 @@ const char *la_item_token(la_item_t *item, size_t *length) {
         offset = 0;
     }
 
-    /* Set new buffer */
+    /* Set new buffer (NULL for inline token, overlaying the offset) */
     item->buff_1st = new_buffer;
-    item->buff_off = 0;
+    if (!is_inline)
+        item->buff_off = 0;
 
-    return buffer_data(new_buffer);
+    return is_inline ? item->token : buffer_data(new_buffer);
 }
 
 
@@ -327,10 +429,10 @@ void la_item_copy(la_item_t *dest, const la_item_t *src) {
 
     memcpy(dest, src, sizeof(la_item_t));
 
-    /* Reference buffer(s) for the destination */
+    /* Reference buffer(s) for the destination (inline token has none) */
     buffer_t *buffer = dest->buff_1st;
     size_t    offset = dest->buff_off;
-    size_t    length = dest->length;
+    size_t    length = NULL != buffer ? dest->length : 0;
 
     while (0 < length) {
         buffer_ref(buffer);
@@ -345,12 +447,48 @@ void la_item_copy(la_item_t *dest, const la_item_t *src) {
 }
 
 
+void la_item_resolve_position(la_item_t *item) {
+    assert(NULL != item);
+
+    /* Position already known */
+    if (item->line) return;
+
+    assert(NULL != item->buff_1st);
+
+    buffer_position(item->buff_1st, item->buff_off, &item->line, &item->column);
+}
+
+
+size_t la_item_lazy_line(const la_item_t *item) {
+    assert(NULL != item);
+    assert(NULL != item->buff_1st);
+
+    size_t line, column;
+
+    buffer_position(item->buff_1st, item->buff_off, &line, &column);
+
+    return line;
+}
+
+
+size_t la_item_lazy_column(const la_item_t *item) {
+    assert(NULL != item);
+    assert(NULL != item->buff_1st);
+
+    size_t line, column;
+
+    buffer_position(item->buff_1st, item->buff_off, &line, &column);
+
+    return column;
+}
+
+
 void la_item_destroy(la_item_t *item) {
     assert(NULL != item);
 
-    /* Unreference buffer(s) */
+    /* Unreference buffer(s) (inline token has none) */
     size_t offset = item->buff_off;
-    size_t length = item->length;
+    size_t length = NULL != item->buff_1st ? item->length : 0;
 
     while (0 < length) {
         buffer_t *buffer = item->buff_1st;
@@ -381,6 +519,10 @@ void la_item_destroy(la_item_t *item) {
  *  \ref la_get_item routine is in fact just a wrapper that provides
  *  the user with result of this function.
  *
+ *  The function segments the input; items of languages skipped
+ *  by the FSA (white spaces, comments etc) are read (i.e. discarded)
+ *  and the segmentation continues.
+ *
  *  Note that the function is only ment as part of the \ref la_get_item
  *  function and is torn from it just to increase readablility.
  *  It changes state of the lexical analyser.
@@ -393,6 +535,36 @@ void la_item_destroy(la_item_t *item) {
 static la_status_t la_get_item__impl(lexa_t *la) {
     assert(NULL != la);
 
+    for (;;) {
+        la_status_t status = la_get_item__segment(la);
+
+        if (LA_OK != status) return status;
+
+        /* Segmentation done, discard skipped item (if any) */
+        int code = la_get_item__skipped(la);
+
+        if (LEXIG_INVALID == code) return status;
+
+        la_read_item(la, code);
+    }
+}
+
+
+/**
+ *  \brief  Segment input to lexical items
+ *
+ *  Note that the function is only ment as part of the \ref la_get_item
+ *  function and is torn from it just to increase readablility.
+ *  It changes state of the lexical analyser.
+ *  Do not use the function for any other purposes.
+ *
+ *  \param  la  Lexical analyser
+ *
+ *  \return Lexical analyser status
+ */
+static la_status_t la_get_item__segment(lexa_t *la) {
+    assert(NULL != la);
+
     /* Input is no more exhausted */
     if (LA_INPUT_EXHAUSTED == la->status && la->buffer)
         la->status = LA_OK;
@@ -433,18 +605,29 @@ static la_status_t la_get_item__impl(lexa_t *la) {
         while (buffer_size(la->buffer) <= la->state.buffer_offset) {
             if (buffer_is_last(la->buffer)) {
                 /* At least one item was parsed */
-                if (la->state.item_cnt)
+                if (la->state.item_cnt) {
+                    la_get_item__memo_overrun(la);
+
                     la->state.fsa_state = NULL;
+                }
 
                 /* EoF (single item) */
                 else if (0 == la->state.token_length) {
-                    la->state.item_list[0].code     = LEXIG_EOF;
-                    la->state.item_list[0].offset   = la->state.token_offset;
-                    la->state.item_list[0].length   = 0;
-                    la->state.item_list[0].line     = la->state.line;
-                    la->state.item_list[0].column   = la->state.column;
-                    la->state.item_list[0].buff_1st = NULL;
-                    la->state.item_list[0].buff_off = 0;
+                    la->state.item_list[0].code      = LEXIG_EOF;
+                    la->state.item_list[0].offset    = la->state.token_offset;
+                    la->state.item_list[0].length    = 0;
+                    la->state.item_list[0].line      = la->state.line;
+                    la->state.item_list[0].column    = la->state.column;
+                    la->state.item_list[0].buff_1st  = NULL;
+                    la->state.item_list[0].buff_off  = 0;
+                    la->state.item_list[0].next_buff = NULL;
+                    la->state.item_list[0].next_off  = 0;
+
+                    /* Resolve EoF position (offset-only tracking) */
+                    if (LA_POS_OFFSET == la->pos_mode)
+                        buffer_end_position(la->buffer,
+                            &la->state.item_list[0].line,
+                            &la->state.item_list[0].column);
 
                     la->state.item_cnt  = 1;
                     la->state.fsa_state = NULL;
@@ -471,8 +654,10 @@ static la_status_t la_get_item__impl(lexa_t *la) {
             }
         }
 
-        /* Branch by the next character in the input */
-        if (NULL == la_get_item__follow_branch(la)) {
+        /* Branch by the next characters in the input */
+        if (NULL == la_get_item__scan(la)) {
+            la_get_item__memo_overrun(la);
+
             /* No items mean invalid input */
             la->status = la->state.item_cnt
                        ? LA_OK : LA_INPUT_INVALID;
@@ -485,6 +670,86 @@ static la_status_t la_get_item__impl(lexa_t *la) {
 }
 
 
+/**
+ *  \brief  Find skipped lexical item
+ *
+ *  The item list is checked for item of a language skipped by the FSA.
+ *  Such an item is only skipped if there's no longer item in the list
+ *  (i.e. the longest match rule applies).
+ *  The segmentation must be complete.
+ *
+ *  Note that the function is only ment as part of the \ref la_get_item
+ *  function and is torn from it just to increase readablility.
+ *  Do not use the function for any other purposes.
+ *
+ *  \param  la  Lexical analyser
+ *
+ *  \return Skipped item code or \ref LEXIG_INVALID if there's none
+ */
+inline static int la_get_item__skipped(const lexa_t *la) {
+    assert(NULL != la);
+
+    size_t skip_cnt = fsa_skip_cnt(la->fsa);
+
+    /* Nothing is ever skipped */
+    if (0 == skip_cnt) return LEXIG_INVALID;
+
+    /* Segmentation isn't complete */
+    if (NULL != la->state.fsa_state) return LEXIG_INVALID;
+
+    int    code   = LEXIG_INVALID;
+    size_t length = 0;
+    size_t i      = 0;
+
+    for (; i < la->state.item_cnt; ++i) {
+        const la_item_t *item = la->state.item_list + i;
+
+        /* Longer item exists */
+        if (item->length > length) {
+            code   = LEXIG_INVALID;
+            length = item->length;
+        }
+
+        /* Shorter item is never skipped */
+        else if (item->length < length || LEXIG_INVALID != code)
+            continue;
+
+        if (la_fsa_skips(la->fsa, item->code))
+            code = item->code;
+    }
+
+    /* Skipping empty item would never end */
+    return length ? code : LEXIG_INVALID;
+}
+
+
+/**
+ *  \brief  Get lexical item position in the item list
+ *
+ *  The item positions array and the item list form a sparse set;
+ *  a position is only valid if it's in the list and the listed
+ *  item code matches.
+ *  Stale positions therefore never need resetting; emptying the list
+ *  invalidates all of them at once.
+ *
+ *  \param  la    Lexical analyser
+ *  \param  code  Lexical item code
+ *
+ *  \return Item position or items total if the item isn't listed
+ */
+inline static size_t la_item_index(const lexa_t *la, int code) {
+    assert(NULL != la);
+    assert(0 <= code && (size_t)code < la->items_total);
+
+    size_t pos = la->state.item_pos[code];
+
+    if (pos < la->state.item_cnt && la->state.item_list[pos].code == code)
+        return pos;
+
+    return la->items_total;
+}
+
+
 /**
  *  \brief  Add lexical items accepted by current FSA state to the item list
  *
@@ -502,7 +767,7 @@ inline static void la_get_item__add_state_accepts(lexa_t *la) {
 
     for (; i < la->state.fsa_state->accept_cnt; ++i) {
         int    code = la->state.fsa_state->accepts[i];
-        size_t pos  = la->state.item_pos[code];
+        size_t pos  = la_item_index(la, code);
 
         /* New item */
         if (pos == la->items_total) {
@@ -523,18 +788,165 @@ inline static void la_get_item__add_state_accepts(lexa_t *la) {
             assert(la->state.item_list[pos].code == code);
         }
 
+        /* Last-accept checkpoint */
         la->state.item_list[pos].length      = la->state.token_length;
         la->state.item_list[pos].next_line   = la->state.line;
         la->state.item_list[pos].next_column = la->state.column;
+        la->state.item_list[pos].next_buff   = la->buffer;
+        la->state.item_list[pos].next_off    = la->state.buffer_offset;
+    }
+
+    if (la->state.fsa_state->accept_cnt)
+        la->state.accept_state = la->state.fsa_state;
+}
+
+
+/**
+ *  \brief  Find target of branch matching character in FSA state
+ *
+ *  The FSA comb-vector transitions are used if available.
+ *  Otherwise, the state dense transition row is used if available;
+ *  otherwise, the branches' character intervals are scanned.
+ *
+ *  \param  fsa    FSA
+ *  \param  state  FSA state
+ *  \param  ch     Input character
+ *
+ *  \return Target state or \c NULL if no branch matches
+ */
+inline static const fsa_state_t *la_get_item__branch_target(const fsa_t *fsa, const fsa_state_t *state, char ch) {
+    assert(NULL != fsa);
+    assert(NULL != state);
+
+    /* Comb-vector (character class and entry lookups) */
+    const fsa_comb_t *comb = fsa_comb(fsa);
+
+    if (NULL != comb) {
+        size_t index = state->comb_base + comb->class_map[(unsigned char)ch];
+
+        /* Out of the vector (e.g. FSA without transitions) */
+        if (!(index < comb->entry_cnt)) return NULL;
+
+        const fsa_comb_entry_t *entry = comb->entries + index;
+
+        return entry->check == state ? entry->target : NULL;
     }
+
+    /* Dense transition row (single lookup) */
+    if (NULL != fsa_state_trans(state))
+        return fsa_state_trans(state)[(unsigned char)ch];
+
+    size_t i = 0;
+
+    for (; i < state->branch_cnt; ++i) {
+        const fsa_branch_t *branch = state->branches[i];
+
+        size_t j = 0;
+
+        for (; j < branch->interval_cnt; ++j) {
+            char lo = branch->intervals[j][0];
+            char hi = branch->intervals[j][1];
+
+            /* Matching branch found */
+            if (lo <= ch && ch <= hi)
+                return branch->target;
+        }
+    }
+
+    return NULL;
 }
 
 
 /**
- *  \brief  Take branch matching character from current FSA state
+ *  \brief  Skip run of FSA state self-loop characters
  *
- *  If there's no matching branch, the function sets current state
- *  to \c NULL.
+ *  AVX2 or SSE2 is used (if available) to check 32 or 16 characters
+ *  at once; the rest is checked one by one.
+ *
+ *  \param  loop  FSA state self-loop
+ *  \param  data  Input data
+ *  \param  size  Input data size
+ *
+ *  \return Length of the self-loop characters run at the data begin
+ */
+inline static size_t la_get_item__skip_loop(const fsa_loop_t *loop, const char *data, size_t size) {
+    assert(NULL != loop);
+
+    size_t off = 0;
+    size_t i;
+
+#if defined(__AVX2__)
+    for (; off + 32 <= size; off += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i *)(data + off));
+        __m256i in    = _mm256_setzero_si256();
+
+        for (i = 0; i < loop->interval_cnt; ++i) {
+            __m256i lo = _mm256_set1_epi8((char)loop->intervals[i][0]);
+            __m256i w  = _mm256_set1_epi8((char)(loop->intervals[i][1] - loop->intervals[i][0]));
+            __m256i d  = _mm256_sub_epi8(chunk, lo);
+
+            /* lo <= ch <= hi iff (unsigned)(ch - lo) <= hi - lo */
+            in = _mm256_or_si256(in, _mm256_cmpeq_epi8(_mm256_min_epu8(d, w), d));
+        }
+
+        unsigned mask = (unsigned)_mm256_movemask_epi8(in);
+
+        if (0xffffffff != mask)
+            return off + __builtin_ctz(~mask);
+    }
+#elif defined(__SSE2__)
+    for (; off + 16 <= size; off += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(data + off));
+        __m128i in    = _mm_setzero_si128();
+
+        for (i = 0; i < loop->interval_cnt; ++i) {
+            __m128i lo = _mm_set1_epi8((char)loop->intervals[i][0]);
+            __m128i w  = _mm_set1_epi8((char)(loop->intervals[i][1] - loop->intervals[i][0]));
+            __m128i d  = _mm_sub_epi8(chunk, lo);
+
+            /* lo <= ch <= hi iff (unsigned)(ch - lo) <= hi - lo */
+            in = _mm_or_si128(in, _mm_cmpeq_epi8(_mm_min_epu8(d, w), d));
+        }
+
+        unsigned mask = (unsigned)_mm_movemask_epi8(in);
+
+        if (0xffff != mask)
+            return off + __builtin_ctz(~mask);
+    }
+#endif
+
+    for (; off < size; ++off) {
+        unsigned char ch = (unsigned char)data[off];
+
+        for (i = 0; i < loop->interval_cnt; ++i)
+            if (loop->intervals[i][0] <= ch && ch <= loop->intervals[i][1])
+                break;
+
+        if (!(i < loop->interval_cnt)) break;
+    }
+
+    return off;
+}
+
+
+/**
+ *  \brief  Scan current input buffer
+ *
+ *  The function follows branches matching characters from the current
+ *  buffer as long as possible.
+ *  FSA state, buffer offset, token length and source position are kept
+ *  in local variables while scanning; the analyser state is only updated
+ *  when the scanning stops.
+ *  That happens when
+ *  - no branch matches the next character (current state is set to \c NULL)
+ *  - an accepting or a dead end state is reached
+ *  - the buffer end is reached
+ *
+ *  If the FSA provides direct-coded scanner, it's used for following
+ *  the branches.
+ *  Overrun of failed scans (see \ref la_memo) is scanned step by step,
+ *  though; the scanning stops (as if no branch matched) as soon as
+ *  a memoised state and position pair is reached.
  *
  *  Note that the function is only ment as part of the \ref la_get_item
  *  function and is torn from it just to increase readablility.
@@ -545,44 +957,480 @@ inline static void la_get_item__add_state_accepts(lexa_t *la) {
  *
  *  \retval  Current FSA state (for branch success checks)
  */
-inline static const fsa_state_t *la_get_item__follow_branch(lexa_t *la) {
+inline static const fsa_state_t *la_get_item__scan(lexa_t *la) {
     assert(NULL != la);
     assert(NULL != la->buffer);
     assert(la->state.buffer_offset < buffer_size(la->buffer));
 
-    char ch = buffer_data(la->buffer)[la->state.buffer_offset];
+    const fsa_t       *fsa    = la->fsa;
+    const fsa_state_t *state  = la->state.fsa_state;
+    const char        *data   = buffer_data(la->buffer);
+    size_t             size   = buffer_size(la->buffer);
+    size_t             offset = la->state.buffer_offset;
+    size_t             length = la->state.token_length;
+    size_t             line   = la->state.line;
+    size_t             column = la->state.column;
 
-    size_t i = 0;
+    const la_memo_t *memo = &la->state.memo;
 
-    for (i = 0; i < la->state.fsa_state->branch_cnt; ++i) {
-        const fsa_branch_t *branch = la->state.fsa_state->branches[i];
+    size_t pos = la->state.token_offset + length;
 
-        size_t j = 0;
+    /* Memoised overrun ahead, step by step */
+    if (pos < memo->end) do {
+        /* No accept ahead */
+        if (la_memo__find(memo, state, pos)) {
+            state = NULL;
 
-        for (; j < branch->interval_cnt; ++j) {
-            char lo = branch->intervals[j][0];
-            char hi = branch->intervals[j][1];
+            break;
+        }
 
-            /* Matching branch found */
-            if (lo <= ch && ch <= hi) {
-                ++la->state.buffer_offset;
-                ++la->state.token_length;
+        char ch = data[offset];
+
+        state = la_get_item__branch_target(fsa, state, ch);
+
+        /* No matching branch */
+        if (NULL == state) break;
+
+        ++offset;
+        ++length;
+        ++pos;
+
+        if (LA_POS_OFFSET != la->pos_mode) {
+            if ('\n' == ch) {
+                ++line;
+                column = 1;
+            }
+            else
+                ++column;
+        }
+
+        /* Accepting or dead end state reached */
+        if (state->accept_cnt || 0 == state->branch_cnt) break;
+
+    } while (offset < size && pos < memo->end);
+
+    /* Direct-coded scanner */
+    else if (NULL != fsa_scan(fsa)) {
+        size_t begin = offset;
+
+        state = fsa_scan(fsa)(state, data, size, &offset);
+
+        length += offset - begin;
+
+        /* Count lines in the scanned characters */
+        if (LA_POS_OFFSET != la->pos_mode) {
+            const char *ch  = data + begin;
+            const char *end = data + offset;
+            const char *nl;
+
+            while (NULL != (nl = (const char *)memchr(ch, '\n', end - ch))) {
+                ++line;
+                column = 1;
+
+                ch = nl + 1;
+            }
+
+            column += end - ch;
+        }
+    }
+
+    /* Track offsets only */
+    else if (LA_POS_OFFSET == la->pos_mode) do {
+        /* Skip self-loop characters run */
+        if (NULL != fsa_state_self_loop(state)) {
+            size_t run = la_get_item__skip_loop(fsa_state_self_loop(state),
+                                                data + offset, size - offset);
+
+            offset += run;
+            length += run;
+
+            /* Accepting state (let the caller add the items) */
+            if (run && state->accept_cnt) break;
+
+            if (offset == size) break;
+        }
+
+        state = la_get_item__branch_target(fsa, state, data[offset]);
 
-                if ('\n' == ch) {
-                    ++la->state.line;
-                    la->state.column = 1;
+        /* No matching branch */
+        if (NULL == state) break;
+
+        ++offset;
+        ++length;
+
+        /* Accepting or dead end state reached */
+        if (state->accept_cnt || 0 == state->branch_cnt) break;
+
+    } while (offset < size);
+
+    /* Track lines and columns, too */
+    else do {
+        /* Skip self-loop characters run */
+        if (NULL != fsa_state_self_loop(state)) {
+            size_t run = la_get_item__skip_loop(fsa_state_self_loop(state),
+                                                data + offset, size - offset);
+
+            /* Count lines in the run (if any) */
+            if (NULL == memchr(data + offset, '\n', run)) {
+                offset += run;
+                column += run;
+            }
+            else {
+                size_t end = offset + run;
+
+                for (; offset < end; ++offset) {
+                    if ('\n' == data[offset]) {
+                        ++line;
+                        column = 1;
+                    }
+                    else
+                        ++column;
                 }
-                else
-                    ++la->state.column;
+            }
+
+            length += run;
+
+            /* Accepting state (let the caller add the items) */
+            if (run && state->accept_cnt) break;
+
+            if (offset == size) break;
+        }
+
+        char ch = data[offset];
+
+        state = la_get_item__branch_target(fsa, state, ch);
+
+        /* No matching branch */
+        if (NULL == state) break;
+
+        ++offset;
+        ++length;
+
+        if ('\n' == ch) {
+            ++line;
+            column = 1;
+        }
+        else
+            ++column;
+
+        /* Accepting or dead end state reached */
+        if (state->accept_cnt || 0 == state->branch_cnt) break;
+
+    } while (offset < size);
+
+    /* Write the analyser state back */
+    la->state.steps        += length - la->state.token_length;
+    la->state.fsa_state     = state;
+    la->state.buffer_offset = offset;
+    la->state.token_length  = length;
+    la->state.line          = line;
+    la->state.column        = column;
+
+    return state;
+}
+
 
-                la->state.fsa_state = branch->target;
+/**
+ *  \brief  Check whether FSA skips language
+ *
+ *  \param  fsa   FSA
+ *  \param  code  Language code
+ *
+ *  \return Non-zero iff the language is skipped
+ */
+inline static int la_fsa_skips(const fsa_t *fsa, int code) {
+    size_t i = 0;
+
+    for (; i < fsa_skip_cnt(fsa); ++i)
+        if ((int)fsa_skips(fsa)[i] == code) return 1;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Tokenize current buffer in batch (tight loop)
+ *
+ *  The FSA is run directly on the current buffer data; recognised
+ *  tokens are appended to the batch (or skipped) and read.
+ *  The function stops at the beginning of a token that requires
+ *  general segmentation (see \ref la_tokenize_batch) or when the batch
+ *  is full.
+ *  It does nothing unless the analyser is at a token beginning
+ *  in its current buffer.
+ *
+ *  \param  la     Lexical analyser
+ *  \param  batch  Lexical items batch
+ */
+static void la_tokenize_batch__buffer(lexa_t *la, la_batch_t *batch) {
+    assert(NULL != la);
+    assert(NULL != batch);
+
+    const fsa_t       *fsa  = la->fsa;
+    const fsa_state_t *root = fsa_root(fsa);
+
+    /* Not at a token beginning in the current buffer */
+    if (LA_OK != la->status || la->state.item_cnt ||
+        root != la->state.fsa_state || la->state.token_length ||
+        NULL == la->buffer || la->state.token_buff != la->buffer)
+        return;
+
+    const char *data   = buffer_data(la->buffer);
+    size_t      size   = buffer_size(la->buffer);
+    size_t      offset = la->state.buffer_offset;
 
-                return la->state.fsa_state;
+    while (batch->cnt < batch->capacity && offset < size) {
+        /* Memoised overrun ahead */
+        if (la->state.token_offset < la->state.memo.end) break;
+
+        const fsa_state_t *state  = root;
+        const fsa_state_t *accept = NULL;
+        size_t             end    = offset;
+        size_t             aend   = offset;
+
+        while (end < size) {
+            state = la_get_item__branch_target(fsa, state, data[end]);
+
+            /* No matching branch */
+            if (NULL == state) break;
+
+            ++end;
+
+            if (state->accept_cnt) {
+                accept = state;
+                aend   = end;
             }
+
+            /* Dead end */
+            if (0 == state->branch_cnt) break;
         }
+
+        la->state.steps += end - offset;
+
+        /* Token may continue in the next buffer */
+        if (NULL != state && end == size && state->branch_cnt) break;
+
+        /* Nothing accepted, ambiguous or overrun token */
+        if (NULL == accept || 1 != accept->accept_cnt || aend != end) break;
+
+        int    code   = (int)accept->accepts[0];
+        size_t length = end - offset;
+
+        /* Append token (unless skipped) */
+        if (!la_fsa_skips(fsa, code)) {
+            size_t idx = batch->cnt++;
+
+            batch->codes[idx]   = code;
+            batch->offsets[idx] = la->state.token_offset;
+            batch->lengths[idx] = length;
+
+            if (NULL != batch->lines || NULL != batch->columns) {
+                size_t line   = la->state.line;
+                size_t column = la->state.column;
+
+                if (LA_POS_OFFSET == la->pos_mode)
+                    buffer_position(la->buffer, offset, &line, &column);
+
+                if (NULL != batch->lines)   batch->lines[idx]   = line;
+                if (NULL != batch->columns) batch->columns[idx] = column;
+            }
+        }
+
+        /* Read token */
+        if (LA_POS_OFFSET != la->pos_mode) {
+            const char *ch  = data + offset;
+            const char *nl;
+
+            while (NULL != (nl = (const char *)memchr(ch, '\n', data + end - ch))) {
+                ++la->state.line;
+                la->state.column = 1;
+
+                ch = nl + 1;
+            }
+
+            la->state.column += data + end - ch;
+        }
+
+        la->state.token_offset += length;
+
+        offset = end;
     }
 
-    return la->state.fsa_state = NULL;
+    la->state.buffer_offset  = offset;
+    la->state.token_buff_off = offset;
+    la->state.token_line     = la->state.line;
+    la->state.token_column   = la->state.column;
+}
+
+
+/**
+ *  \brief  Memoise overrun of failed scan
+ *
+ *  The scan failed (no branch matched or the input ended);
+ *  the overrun (i.e. the characters after the last accept) is replayed
+ *  from the last accept checkpoint and the visited FSA state and input
+ *  position pairs are memoised (see \ref la_memo).
+ *
+ *  Note that the function is only ment as part of the \ref la_get_item
+ *  function and is torn from it just to increase readablility.
+ *  Do not use the function for any other purposes.
+ *
+ *  \param  la  Lexical analyser
+ */
+static void la_get_item__memo_overrun(lexa_t *la) {
+    assert(NULL != la);
+
+    /* Nothing was accepted (the analysis fails anyway) */
+    if (0 == la->state.item_cnt) return;
+
+    /* The longest item ends at the last accept */
+    const la_item_t *item = la->state.item_list;
+
+    size_t i = 1;
+
+    for (; i < la->state.item_cnt; ++i)
+        if (la->state.item_list[i].length > item->length)
+            item = la->state.item_list + i;
+
+    size_t pos = la->state.token_offset + item->length;
+    size_t end = la->state.token_offset + la->state.token_length;
+
+    /* No overrun */
+    if (pos == end) return;
+
+    la_memo_t *memo = &la->state.memo;
+
+    /* Memoised positions were all passed */
+    if (memo->end <= la->state.token_offset)
+        la_memo__clear(memo);
+
+    const fsa_state_t *state  = la->state.accept_state;
+    buffer_t          *buffer = item->next_buff;
+    size_t             offset = item->next_off;
+
+    for (;; ++pos) {
+        la_memo__insert(memo, state, pos);
+
+        if (pos == end) break;
+
+        while (buffer_size(buffer) <= offset) {
+            buffer = buffer_get_next(buffer);
+            offset = 0;
+
+            assert(NULL != buffer);
+        }
+
+        state = la_get_item__branch_target(la->fsa, state, buffer_data(buffer)[offset++]);
+
+        assert(NULL != state);
+
+        ++la->state.steps;
+    }
+}
+
+
+/**
+ *  \brief  Find failed scan memo entry
+ *
+ *  \param  memo   Failed scans memo
+ *  \param  state  FSA state
+ *  \param  pos    Input position
+ *
+ *  \return Non-zero iff the state and position pair is memoised
+ */
+inline static int la_memo__find(const la_memo_t *memo, const fsa_state_t *state, size_t pos) {
+    assert(NULL != memo);
+
+    if (!(pos < memo->end)) return 0;
+
+    size_t mask = memo->capacity - 1;
+    size_t i    = LA_MEMO_HASH(state, pos) & mask;
+
+    for (; NULL != memo->entries[i].state; i = (i + 1) & mask)
+        if (memo->entries[i].state == state && memo->entries[i].position == pos)
+            return 1;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Add failed scan memo entry
+ *
+ *  The hash table is open-addressed (linear probing);
+ *  it's kept at most half full.
+ *  Memory errors are ignored (the memo isn't necessary for
+ *  correct analysis).
+ *
+ *  \param  memo   Failed scans memo
+ *  \param  state  FSA state
+ *  \param  pos    Input position
+ */
+inline static void la_memo__insert(la_memo_t *memo, const fsa_state_t *state, size_t pos) {
+    assert(NULL != memo);
+    assert(NULL != state);
+
+    /* Grow the table */
+    if (memo->capacity < 2 * (memo->cnt + 1)) {
+        size_t capacity = memo->capacity ? 2 * memo->capacity : LA_MEMO_CAPACITY_MIN;
+
+        la_memo_entry_t *entries = (la_memo_entry_t *)
+            calloc(capacity, sizeof(la_memo_entry_t));
+
+        if (NULL == entries) return;
+
+        size_t i = 0;
+
+        for (; i < memo->capacity; ++i) {
+            const la_memo_entry_t *entry = memo->entries + i;
+
+            if (NULL == entry->state) continue;
+
+            size_t j = LA_MEMO_HASH(entry->state, entry->position) & (capacity - 1);
+
+            while (NULL != entries[j].state)
+                j = (j + 1) & (capacity - 1);
+
+            entries[j] = *entry;
+        }
+
+        free(memo->entries);
+
+        memo->entries  = entries;
+        memo->capacity = capacity;
+    }
+
+    size_t mask = memo->capacity - 1;
+    size_t i    = LA_MEMO_HASH(state, pos) & mask;
+
+    for (; NULL != memo->entries[i].state; i = (i + 1) & mask)
+        if (memo->entries[i].state == state && memo->entries[i].position == pos)
+            return;
+
+    memo->entries[i].state    = state;
+    memo->entries[i].position = pos;
+
+    ++memo->cnt;
+
+    if (memo->end <= pos)
+        memo->end = pos + 1;
+}
+
+
+/**
+ *  \brief  Empty failed scans memo
+ *
+ *  The hash table is freed (so that the memo doesn't keep
+ *  the largest size ever used).
+ *
+ *  \param  memo  Failed scans memo
+ */
+inline static void la_memo__clear(la_memo_t *memo) {
+    assert(NULL != memo);
+
+    free(memo->entries);
+
+    memset(memo, 0, sizeof(*memo));
 }
 
 
@@ -32,13 +32,32 @@
 #include <string.h>
 
 
+/*
+ * Static functions prototypes
+ */
+
+inline static void *objpool_malloc(const objpool_t *pool);
+
+
+/*
+ * Interface definition
+ */
+
 void objpool_init(objpool_t *pool, size_t size, size_t cache_max, size_t prealloc_cnt) {
+    objpool_init_aligned(pool, size, 0, cache_max, prealloc_cnt);
+}
+
+
+void objpool_init_aligned(objpool_t *pool, size_t size, size_t align, size_t cache_max, size_t prealloc_cnt) {
     assert(NULL != pool);
+    assert(0 == align % sizeof(void *));
+    assert(0 == (align & (align - 1)));
 
     memset(pool, 0, sizeof(objpool_t));
 
-    pool->size      = size;
+    pool->size      = size < sizeof(void *) ? sizeof(void *) : size;
     pool->cache_max = cache_max;
+    pool->align     = align;
 
     objpool_prealloc(pool, prealloc_cnt);
 }
@@ -60,7 +79,7 @@ void *objpool_alloc(objpool_t *pool) {
 
     /* Allocation is necessary */
     else {
-        obj = malloc(pool->size);
+        obj = objpool_malloc(pool);
 
         if (NULL != obj)
             ++pool->cnt;
@@ -81,7 +100,7 @@ void objpool_prealloc(objpool_t *pool, size_t cnt) {
     assert(NULL != pool);
 
     while (cnt--) {
-        void *obj = malloc(pool->size);
+        void *obj = objpool_malloc(pool);
         if (NULL == obj) break;
 
         *(void **)obj = pool->cache;
@@ -144,3 +163,26 @@ void objpool_finalise(objpool_t *pool) {
     assert(0 == pool->cnt);
     assert(0 == pool->cache_cnt);
 }
+
+
+/*
+ * Static functions definitions
+ */
+
+/**
+ *  \brief  Allocate object memory (using system allocator)
+ *
+ *  \param  pool  Object pool
+ *
+ *  \return Object memory or \c NULL in case of memory error
+ */
+inline static void *objpool_malloc(const objpool_t *pool) {
+    assert(NULL != pool);
+
+    if (0 == pool->align)
+        return malloc(pool->size);
+
+    void *obj;
+
+    return posix_memalign(&obj, pool->align, pool->size) ? NULL : obj;
+}
@@ -0,0 +1,394 @@
+/**
+ *  \brief  Pipelined syntax analysis
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sa_pipeline.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/*
+ * Static functions prototypes
+ */
+
+static void *sa_pipeline_read(void *arg);
+
+static void *sa_pipeline_lex(void *arg);
+
+static void sa_pipeline_batch_clear(sa_pipeline_batch_t *batch);
+
+
+/*
+ * Interface definition
+ */
+
+sa_pipeline_t *sa_pipeline_create(sa_pipeline_t         *pipe,
+                                  syxa_t                *sa,
+                                  sa_pipeline_source_fn *source_fn,
+                                  void                  *source,
+                                  size_t                 batch_size)
+{
+    assert(NULL != pipe);
+    assert(NULL != sa);
+    assert(NULL != source_fn);
+    assert(0 < batch_size);
+
+    pipe->sa          = sa;
+    pipe->source_fn   = source_fn;
+    pipe->source      = source;
+    pipe->batch_size  = batch_size;
+    pipe->source_erno = 0;
+    pipe->la_status   = LA_OK;
+
+    /*
+     * Lexical item batches (all allocated at once)
+     * Alternatives may follow the last unambiguous item.
+     */
+    size_t batch_cap = batch_size + sa->la.items_total - 1;
+
+    pipe->batches = (sa_pipeline_batch_t *)malloc(SA_PIPELINE_BATCHES *
+        (sizeof(sa_pipeline_batch_t) + batch_cap * sizeof(la_item_t)));
+
+    if (NULL == pipe->batches) return NULL;
+
+    la_item_t *items = (la_item_t *)(pipe->batches + SA_PIPELINE_BATCHES);
+
+    size_t i = 0;
+
+    for (; i < SA_PIPELINE_BATCHES; ++i) {
+        pipe->batches[i].cnt       = 0;
+        pipe->batches[i].items     = items + i * batch_cap;
+        pipe->batches[i].ambiguous = 0;
+    }
+
+    /* Queues (batch queues must hold all the batches and the end mark) */
+    if (NULL == spsc_queue_create(&pipe->buffers, SA_PIPELINE_BUFFERS)) {
+        free(pipe->batches);
+
+        return NULL;
+    }
+
+    if (NULL == spsc_queue_create(&pipe->full, SA_PIPELINE_BATCHES + 1)) {
+        spsc_queue_destroy(&pipe->buffers);
+        free(pipe->batches);
+
+        return NULL;
+    }
+
+    if (NULL == spsc_queue_create(&pipe->empty, SA_PIPELINE_BATCHES)) {
+        spsc_queue_destroy(&pipe->full);
+        spsc_queue_destroy(&pipe->buffers);
+        free(pipe->batches);
+
+        return NULL;
+    }
+
+    if (NULL == spsc_queue_create(&pipe->choices, 1)) {
+        spsc_queue_destroy(&pipe->empty);
+        spsc_queue_destroy(&pipe->full);
+        spsc_queue_destroy(&pipe->buffers);
+        free(pipe->batches);
+
+        return NULL;
+    }
+
+    return pipe;
+}
+
+
+void sa_pipeline_destroy(sa_pipeline_t *pipe) {
+    assert(NULL != pipe);
+
+    size_t i = 0;
+
+    for (; i < SA_PIPELINE_BATCHES; ++i)
+        sa_pipeline_batch_clear(pipe->batches + i);
+
+    spsc_queue_destroy(&pipe->choices);
+    spsc_queue_destroy(&pipe->empty);
+    spsc_queue_destroy(&pipe->full);
+    spsc_queue_destroy(&pipe->buffers);
+
+    free(pipe->batches);
+}
+
+
+sa_status_t sa_pipeline_parse(sa_pipeline_t *pipe) {
+    assert(NULL != pipe);
+
+    syxa_t *sa = pipe->sa;
+
+    /* All batches are available to the lexer */
+    size_t i = 0;
+
+    for (; i < SA_PIPELINE_BATCHES; ++i)
+        spsc_queue_push(&pipe->empty, pipe->batches + i);
+
+    /* Start reader & lexer */
+    if (pthread_create(&pipe->reader, NULL, &sa_pipeline_read, pipe))
+        return sa->status = SA_ERROR;
+
+    if (pthread_create(&pipe->lexer, NULL, &sa_pipeline_lex, pipe)) {
+        spsc_queue_cancel(&pipe->buffers);
+
+        pthread_join(pipe->reader, NULL);
+
+        return sa->status = SA_ERROR;
+    }
+
+    /* Parse lexical items batches */
+    sa_status_t status = SA_OK;
+
+    while (!sa_accept(sa)) {
+        sa_pipeline_batch_t *batch;
+
+        spsc_queue_pop(&pipe->full, (void **)&batch);
+
+        /* Lexer stage ended prematurely */
+        if (NULL == batch) {
+            status = LA_INPUT_INVALID == pipe->la_status
+                   ? SA_SYNTAX_ERROR : SA_ERROR;
+
+            sa->status = status;
+
+            break;
+        }
+
+        sa_set_items(sa, batch->items, batch->cnt);
+
+        status = sa_parse(sa);
+
+        sa_set_items(sa, NULL, 0);
+
+        int ambiguous = batch->ambiguous;
+
+        sa_pipeline_batch_clear(batch);
+
+        spsc_queue_push(&pipe->empty, batch);
+
+        if (SA_INPUT_EXHAUSTED != status) break;
+
+        /* Tell the lexer which alternative was shifted */
+        if (ambiguous)
+            spsc_queue_push(&pipe->choices,
+                (void *)(intptr_t)sa_shifted_item_code(sa));
+    }
+
+    /* Stop the stages */
+    spsc_queue_cancel(&pipe->full);
+    spsc_queue_cancel(&pipe->empty);
+    spsc_queue_cancel(&pipe->choices);
+    spsc_queue_cancel(&pipe->buffers);
+
+    pthread_join(pipe->lexer,  NULL);
+    pthread_join(pipe->reader, NULL);
+
+    /* Drop unprocessed buffers (batches are cleared on destruction) */
+    buffer_t *buffer;
+
+    while (0 == spsc_queue_pop(&pipe->buffers, (void **)&buffer))
+        if (NULL != buffer) buffer_unref(buffer);
+
+    return status;
+}
+
+
+/*
+ * Static functions definitions
+ */
+
+/**
+ *  \brief  Reader thread routine
+ *
+ *  Source buffers are pushed to the buffers queue; end of the source
+ *  (or its failure) is marked by \c NULL.
+ *
+ *  \param  arg  Pipeline
+ *
+ *  \return \c NULL
+ */
+static void *sa_pipeline_read(void *arg) {
+    sa_pipeline_t *pipe = (sa_pipeline_t *)arg;
+
+    assert(NULL != pipe);
+
+    int last = 0;
+
+    while (!last) {
+        buffer_t *buffer;
+
+        int erno = pipe->source_fn(pipe->source, &buffer, &last);
+
+        if (erno) {
+            if (ENODATA != erno) pipe->source_erno = erno;
+
+            break;
+        }
+
+        /* Pipeline was cancelled */
+        if (spsc_queue_push(&pipe->buffers, buffer)) {
+            buffer_unref(buffer);
+
+            return NULL;
+        }
+    }
+
+    spsc_queue_push(&pipe->buffers, NULL);
+
+    return NULL;
+}
+
+
+/**
+ *  \brief  Lexer thread routine
+ *
+ *  Source buffers are segmented by the syntax analyser lexical analyser;
+ *  lexical items are copied to batches, which are pushed to the full
+ *  batches queue when full (or at end of file).
+ *  Lexical item alternatives end the batch; the lexer waits for
+ *  the parser choice then.
+ *  End of lexical analysis (or its failure) is marked by \c NULL.
+ *
+ *  \param  arg  Pipeline
+ *
+ *  \return \c NULL
+ */
+static void *sa_pipeline_lex(void *arg) {
+    sa_pipeline_t *pipe = (sa_pipeline_t *)arg;
+
+    assert(NULL != pipe);
+
+    lexa_t *la = &pipe->sa->la;
+
+    sa_pipeline_batch_t *batch  = NULL;
+    la_status_t          status = LA_OK;
+
+    for (int eof = 0; !eof; ) {
+        /* Get empty batch */
+        if (NULL == batch && spsc_queue_pop(&pipe->empty, (void **)&batch))
+            return NULL;  /* cancelled */
+
+        const la_item_t *items;
+        size_t           item_cnt;
+
+        status = la_get_items(la, &items, &item_cnt);
+
+        /* Get another source buffer */
+        if (LA_INPUT_EXHAUSTED == status) {
+            buffer_t *buffer;
+
+            if (spsc_queue_pop(&pipe->buffers, (void **)&buffer))
+                return NULL;  /* cancelled */
+
+            /* Source failed */
+            if (NULL == buffer) {
+                status = LA_ERROR;
+
+                break;
+            }
+
+            la_add_buffer(la, buffer);
+
+            buffer_unref(buffer);
+
+            continue;
+        }
+
+        if (LA_OK != status) break;
+
+        /* Copy the item(s) */
+        size_t i = 0;
+
+        for (; i < item_cnt; ++i) {
+            la_item_t *copy = batch->items + batch->cnt++;
+
+            la_item_copy(copy, items + i);
+
+            if (LEXIG_EOF != la_item_code(copy))
+                la_item_resolve_position(copy);
+        }
+
+        int item_code = la_item_code(items);
+        int ambiguous = 1 < item_cnt;
+
+        batch->ambiguous = ambiguous;
+
+        /* End of file */
+        if (LEXIG_EOF == item_code) eof = 1;
+
+        /* Pass the batch to parser */
+        if (eof || ambiguous || batch->cnt >= pipe->batch_size) {
+            if (spsc_queue_push(&pipe->full, batch))
+                return NULL;  /* cancelled */
+
+            /* Wait for the parser choice */
+            if (ambiguous) {
+                void *choice;
+
+                if (spsc_queue_pop(&pipe->choices, &choice))
+                    return NULL;  /* cancelled */
+
+                item_code = (int)(intptr_t)choice;
+            }
+
+            batch = NULL;
+        }
+
+        if (!eof) la_read_item(la, item_code);
+    }
+
+    /* Items preceding an error are passed, too */
+    if (NULL != batch && batch->cnt) {
+        if (spsc_queue_push(&pipe->full, batch))
+            return NULL;  /* cancelled */
+    }
+
+    pipe->la_status = status;
+
+    spsc_queue_push(&pipe->full, NULL);
+
+    return NULL;
+}
+
+
+/**
+ *  \brief  Destroy lexical items of batch
+ *
+ *  \param  batch  Lexical items batch
+ */
+static void sa_pipeline_batch_clear(sa_pipeline_batch_t *batch) {
+    assert(NULL != batch);
+
+    size_t i = 0;
+
+    for (; i < batch->cnt; ++i)
+        la_item_destroy(batch->items + i);
+
+    batch->cnt = 0;
+}
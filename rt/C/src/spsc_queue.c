@@ -0,0 +1,213 @@
+/**
+ *  \brief  Single-producer/single-consumer queue
+ *
+ *  IMPLEMENTATION NOTES:
+ *  The producer only writes the tail, the consumer only writes the head.
+ *  A side that finds the queue full (or empty) registers as a waiter
+ *  and re-checks the queue under the lock before it waits.
+ *  The other side checks the waiters count after it has moved its position;
+ *  since both the count and the positions are accessed in sequentially
+ *  consistent manner, either the waiting side sees the new position
+ *  or the other side sees the waiter (and signals under the lock),
+ *  so no wake-up is lost.
+ *  Waiters are counted (rather than flagged) since a side may pass
+ *  through the waiting routine while the other one sleeps in it.
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spsc_queue.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+
+
+/** Atomic load */
+#define spsc_load(ptr) __atomic_load_n((ptr), __ATOMIC_SEQ_CST)
+
+/** Atomic store */
+#define spsc_store(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_SEQ_CST)
+
+
+/*
+ * Static functions prototypes
+ */
+
+static int spsc_queue_wait(spsc_queue_t *queue, int for_push);
+
+inline static void spsc_queue_notify(spsc_queue_t *queue);
+
+
+/*
+ * Interface definition
+ */
+
+spsc_queue_t *spsc_queue_create(spsc_queue_t *queue, size_t cap) {
+    assert(NULL != queue);
+    assert(0 < cap);
+
+    queue->impl = (void **)malloc(cap * sizeof(void *));
+
+    if (NULL == queue->impl) return NULL;
+
+    queue->cap       = cap;
+    queue->head      = 0;
+    queue->tail      = 0;
+    queue->waiting   = 0;
+    queue->cancelled = 0;
+
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+
+    return queue;
+}
+
+
+void spsc_queue_destroy(spsc_queue_t *queue) {
+    assert(NULL != queue);
+
+    pthread_cond_destroy(&queue->cond);
+    pthread_mutex_destroy(&queue->mutex);
+
+    free(queue->impl);
+}
+
+
+int spsc_queue_push(spsc_queue_t *queue, void *obj) {
+    assert(NULL != queue);
+
+    size_t tail = queue->tail;  /* only the producer writes it */
+
+    if (spsc_load(&queue->cancelled)) return ECANCELED;
+
+    /* Queue is full */
+    if (tail - spsc_load(&queue->head) == queue->cap) {
+        int erno = spsc_queue_wait(queue, 1);
+
+        if (erno) return erno;
+    }
+
+    queue->impl[tail % queue->cap] = obj;
+
+    spsc_store(&queue->tail, tail + 1);
+
+    spsc_queue_notify(queue);
+
+    return 0;
+}
+
+
+int spsc_queue_pop(spsc_queue_t *queue, void **obj) {
+    assert(NULL != queue);
+    assert(NULL != obj);
+
+    size_t head = queue->head;  /* only the consumer writes it */
+
+    /* Queue is empty */
+    if (head == spsc_load(&queue->tail)) {
+        int erno = spsc_queue_wait(queue, 0);
+
+        if (erno) return erno;
+    }
+
+    *obj = queue->impl[head % queue->cap];
+
+    spsc_store(&queue->head, head + 1);
+
+    spsc_queue_notify(queue);
+
+    return 0;
+}
+
+
+void spsc_queue_cancel(spsc_queue_t *queue) {
+    assert(NULL != queue);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    spsc_store(&queue->cancelled, 1);
+
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+
+/*
+ * Static functions definitions
+ */
+
+/**
+ *  \brief  Wait until the queue isn't full (or empty)
+ *
+ *  \param  queue     Queue
+ *  \param  for_push  Non-zero means waiting for space (producer),
+ *                    zero means waiting for an object (consumer)
+ *
+ *  \retval 0          if the queue is ready
+ *  \retval ECANCELED  if the queue was cancelled
+ */
+static int spsc_queue_wait(spsc_queue_t *queue, int for_push) {
+    int erno = 0;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    __atomic_add_fetch(&queue->waiting, 1, __ATOMIC_SEQ_CST);
+
+    for (;;) {
+        size_t cnt = spsc_load(&queue->tail) - spsc_load(&queue->head);
+
+        if (for_push ? cnt < queue->cap : 0 < cnt) break;
+
+        if (spsc_load(&queue->cancelled)) {
+            erno = ECANCELED;
+
+            break;
+        }
+
+        pthread_cond_wait(&queue->cond, &queue->mutex);
+    }
+
+    __atomic_sub_fetch(&queue->waiting, 1, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return erno;
+}
+
+
+/**
+ *  \brief  Wake up the other side (if it waits)
+ *
+ *  \param  queue  Queue
+ */
+inline static void spsc_queue_notify(spsc_queue_t *queue) {
+    if (!spsc_load(&queue->waiting)) return;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    pthread_cond_broadcast(&queue->cond);
+
+    pthread_mutex_unlock(&queue->mutex);
+}
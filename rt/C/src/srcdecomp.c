@@ -0,0 +1,714 @@
+/**
+ *  \brief  Decompressing source
+ *
+ *  The file is part of CTX Fryer C target language libraries.
+ *
+ *  \date  2026/10/16
+ *
+ *  \author  Vaclav Krpec <vencik@razdva.cz>
+ *
+ *  Legal notices
+ *
+ *  Copyright 2026 Vaclav Krpec
+ *
+ *  CTX Fryer C library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include "srcdecomp.h"
+
+#include <assert.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+
+#if defined HAVE_ZLIB_H && defined HAVE_LIBZ
+#define SRCDECOMP_WITH_GZIP
+#include <zlib.h>
+#endif
+
+#if defined HAVE_ZSTD_H && defined HAVE_LIBZSTD
+#define SRCDECOMP_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+
+/** Max. amount of cached output blocks */
+#define SRCDECOMP_BLOCK_CACHE_MAX 16
+
+
+/*
+ * Static functions prototypes
+ */
+
+static int srcdecomp_read_input(srcdecomp_t *dec);
+
+static srcdecomp_format_t srcdecomp_detect(const buffer_t *input);
+
+static int srcdecomp_codec_init(srcdecomp_t *dec);
+
+static int srcdecomp_codec_reset(srcdecomp_t *dec);
+
+inline static int srcdecomp_codec_step(srcdecomp_t *dec,
+                                       const char *in,  size_t in_size,  size_t *consumed,
+                                       char       *out, size_t out_size, size_t *produced);
+
+static void srcdecomp_codec_free(srcdecomp_t *dec);
+
+static void srcdecomp_fill(srcdecomp_t *dec, srcdecomp_slot_t *slot);
+
+static void *srcdecomp_routine(void *arg);
+
+
+/*
+ * Interface definition
+ */
+
+int srcdecomp_format_supported(srcdecomp_format_t format) {
+    switch (format) {
+        case SRCDECOMP_AUTO:
+        case SRCDECOMP_NONE:
+            return 1;
+
+        case SRCDECOMP_GZIP:
+#ifdef SRCDECOMP_WITH_GZIP
+            return 1;
+#else
+            return 0;
+#endif
+
+        case SRCDECOMP_ZSTD:
+#ifdef SRCDECOMP_WITH_ZSTD
+            return 1;
+#else
+            return 0;
+#endif
+    }
+
+    return 0;
+}
+
+
+void srcdecomp_create(srcdecomp_t *dec, srcfile_t *srcf, srcdecomp_format_t format,
+                      size_t block_size, int threaded)
+{
+    assert(NULL != dec);
+    assert(NULL != srcf);
+    assert(0 < block_size);
+
+    memset(dec, 0, sizeof(srcdecomp_t));
+
+    dec->srcf       = srcf;
+    dec->format     = format;
+    dec->block_size = block_size;
+    dec->threaded   = threaded;
+
+    pthread_mutex_init(&dec->mutex, NULL);
+    pthread_cond_init(&dec->not_empty, NULL);
+    pthread_cond_init(&dec->not_full,  NULL);
+}
+
+
+int srcdecomp_open(srcdecomp_t *dec) {
+    assert(NULL != dec);
+    assert(NULL == dec->pool);
+
+    int erno = srcfile_open(dec->srcf);
+
+    if (erno) return erno;
+
+    dec->pool = srcfile_block_pool_create(dec->block_size, 0, SRCDECOMP_BLOCK_CACHE_MAX);
+
+    if (NULL == dec->pool) return ENOMEM;
+
+    /* Detect format from the 1st input buffer */
+    if (SRCDECOMP_AUTO == dec->format) {
+        erno = srcdecomp_read_input(dec);
+
+        if (erno) return erno;
+
+        dec->format = srcdecomp_detect(dec->input);
+    }
+
+    if (!srcdecomp_format_supported(dec->format)) return ENOTSUP;
+
+    erno = srcdecomp_codec_init(dec);
+
+    if (erno) return erno;
+
+    /* Start decompression thread */
+    if (dec->threaded) {
+        erno = pthread_create(&dec->thread, NULL, &srcdecomp_routine, dec);
+
+        if (erno) return erno;
+
+        dec->running = 1;
+    }
+
+    return 0;
+}
+
+
+int srcdecomp_close(srcdecomp_t *dec) {
+    assert(NULL != dec);
+
+    /* Stop decompression thread */
+    if (dec->running) {
+        pthread_mutex_lock(&dec->mutex);
+
+        dec->stop = 1;
+
+        pthread_cond_signal(&dec->not_full);
+        pthread_mutex_unlock(&dec->mutex);
+
+        pthread_join(dec->thread, NULL);
+
+        dec->running = 0;
+
+        /* Drop undelivered blocks */
+        for (; dec->queue_cnt; --dec->queue_cnt) {
+            srcdecomp_slot_t *slot = dec->queue + dec->queue_head;
+
+            if (NULL != slot->data)
+                srcfile_block_pool_free(dec->pool, slot->data, slot->size);
+
+            dec->queue_head = (dec->queue_head + 1) % SRCDECOMP_QUEUE_SIZE;
+        }
+    }
+
+    if (NULL != dec->input) {
+        buffer_destroy(dec->input);
+
+        dec->input = NULL;
+    }
+
+    srcdecomp_codec_free(dec);
+
+    /* Release the block pool (buffers may still hold it) */
+    if (NULL != dec->pool) {
+        srcfile_block_pool_release(dec->pool);
+
+        dec->pool = NULL;
+    }
+
+    return srcfile_close(dec->srcf);
+}
+
+
+void srcdecomp_destroy(srcdecomp_t *dec) {
+    assert(NULL != dec);
+
+    srcdecomp_close(dec);
+
+    pthread_cond_destroy(&dec->not_full);
+    pthread_cond_destroy(&dec->not_empty);
+    pthread_mutex_destroy(&dec->mutex);
+}
+
+
+int srcdecomp_next_buffer(srcdecomp_t *dec, buffer_t **buffer, int *last) {
+    assert(NULL != dec);
+    assert(NULL != buffer);
+    assert(NULL != dec->pool);
+
+    if (dec->erno) return dec->erno;
+
+    if (dec->eof) return ENODATA;
+
+    srcdecomp_slot_t slot;
+
+    /* Take decompressed block from queue */
+    if (dec->threaded) {
+        assert(dec->running);
+
+        pthread_mutex_lock(&dec->mutex);
+
+        while (0 == dec->queue_cnt)
+            pthread_cond_wait(&dec->not_empty, &dec->mutex);
+
+        slot = dec->queue[dec->queue_head];
+
+        dec->queue_head = (dec->queue_head + 1) % SRCDECOMP_QUEUE_SIZE;
+        --dec->queue_cnt;
+
+        pthread_cond_signal(&dec->not_full);
+        pthread_mutex_unlock(&dec->mutex);
+    }
+
+    /* Decompress block */
+    else
+        srcdecomp_fill(dec, &slot);
+
+    /* Errors are sticky (the decompression can't continue) */
+    if (slot.erno) return dec->erno = slot.erno;
+
+    *buffer = buffer_create(slot.data, slot.size, &srcfile_block_pool_free,
+                            dec->pool, slot.last);
+
+    if (NULL == *buffer) {
+        srcfile_block_pool_free(dec->pool, slot.data, slot.size);
+
+        return dec->erno = ENOMEM;
+    }
+
+    dec->eof = slot.last;
+
+    if (NULL != last) *last = slot.last;
+
+    return 0;
+}
+
+
+/*
+ * Static functions definitions
+ */
+
+/**
+ *  \brief  Read next input buffer
+ *
+ *  The current input buffer is released.
+ *  If there's no more input, the input is \c NULL.
+ *
+ *  \param  dec  Decompressing source
+ *
+ *  \retval 0      on success
+ *  \retval errno  on source file reading error
+ */
+static int srcdecomp_read_input(srcdecomp_t *dec) {
+    assert(NULL != dec);
+
+    if (NULL != dec->input) {
+        buffer_destroy(dec->input);
+
+        dec->input = NULL;
+    }
+
+    dec->input_pos = 0;
+
+    buffer_t *input;
+    int       last;
+
+    int erno = srcfile_next_buffer(dec->srcf, &input, &last);
+
+    if (ENODATA == erno) {
+        dec->input_eof = 1;
+
+        return 0;
+    }
+
+    if (erno) return erno;
+
+    dec->input     = input;
+    dec->input_eof = last;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Detect compression format
+ *
+ *  The format is detected by the magic number at the source begin.
+ *
+ *  \param  input  The 1st input buffer (may be \c NULL)
+ *
+ *  \return Compression format
+ */
+static srcdecomp_format_t srcdecomp_detect(const buffer_t *input) {
+    static const unsigned char gzip_magic[] = { 0x1f, 0x8b };
+    static const unsigned char zstd_magic[] = { 0x28, 0xb5, 0x2f, 0xfd };
+
+    if (NULL == input) return SRCDECOMP_NONE;
+
+    const char *data = buffer_data(input);
+    size_t      size = buffer_size(input);
+
+    if (size >= sizeof(gzip_magic) &&
+        0 == memcmp(data, gzip_magic, sizeof(gzip_magic)))
+        return SRCDECOMP_GZIP;
+
+    if (size >= sizeof(zstd_magic) &&
+        0 == memcmp(data, zstd_magic, sizeof(zstd_magic)))
+        return SRCDECOMP_ZSTD;
+
+    return SRCDECOMP_NONE;
+}
+
+
+/**
+ *  \brief  Initialise decompressor
+ *
+ *  \param  dec  Decompressing source
+ *
+ *  \retval 0        on success
+ *  \retval ENOMEM   on memory error
+ *  \retval ENOTSUP  if the format isn't supported
+ */
+static int srcdecomp_codec_init(srcdecomp_t *dec) {
+    assert(NULL != dec);
+    assert(NULL == dec->codec);
+
+    switch (dec->format) {
+        case SRCDECOMP_NONE:
+
+            /* Uncompressed data is complete at any point */
+            dec->frame_end = 1;
+
+            return 0;
+
+#ifdef SRCDECOMP_WITH_GZIP
+        case SRCDECOMP_GZIP: {
+            z_stream *zs = (z_stream *)calloc(1, sizeof(z_stream));
+
+            if (NULL == zs) return ENOMEM;
+
+            /* Window size 2^15 (max.), gzip or zlib header detected */
+            if (Z_OK != inflateInit2(zs, 15 + 32)) {
+                free(zs);
+                return ENOMEM;
+            }
+
+            dec->codec = zs;
+
+            return 0;
+        }
+#endif
+
+#ifdef SRCDECOMP_WITH_ZSTD
+        case SRCDECOMP_ZSTD:
+
+            dec->codec = ZSTD_createDCtx();
+
+            return NULL == dec->codec ? ENOMEM : 0;
+#endif
+
+        default:
+            break;
+    }
+
+    return ENOTSUP;
+}
+
+
+/**
+ *  \brief  Reset decompressor for the next compressed frame
+ *
+ *  Concatenated gzip members (and Zstandard frames) are decompressed
+ *  as a single stream (the same way as \c gzip \c -d does).
+ *
+ *  \param  dec  Decompressing source
+ *
+ *  \retval 0        on success
+ *  \retval EBADMSG  on decompressor error
+ */
+static int srcdecomp_codec_reset(srcdecomp_t *dec) {
+    assert(NULL != dec);
+
+    switch (dec->format) {
+#ifdef SRCDECOMP_WITH_GZIP
+        case SRCDECOMP_GZIP:
+
+            if (Z_OK != inflateReset((z_stream *)dec->codec)) return EBADMSG;
+
+            break;
+#endif
+
+        default:  /* nothing to be done */
+            return 0;
+    }
+
+    dec->frame_end = 0;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Decompress data
+ *
+ *  Decompresses as much of the input as fits to the output.
+ *  The frame end flag is set when a compressed frame is complete.
+ *  Note that the decompressor may produce output even if there's
+ *  no input (it may have buffered some output, before).
+ *
+ *  \param  dec       Decompressing source
+ *  \param  in        Input
+ *  \param  in_size   Input size
+ *  \param  consumed  Amount of input consumed
+ *  \param  out       Output
+ *  \param  out_size  Output size
+ *  \param  produced  Amount of output produced
+ *
+ *  \retval 0        on success
+ *  \retval EBADMSG  if the compressed data is corrupt
+ *  \retval ENOMEM   on memory error
+ */
+inline static int srcdecomp_codec_step(srcdecomp_t *dec,
+                                       const char *in,  size_t in_size,  size_t *consumed,
+                                       char       *out, size_t out_size, size_t *produced)
+{
+    assert(NULL != dec);
+    assert(NULL != consumed);
+    assert(NULL != produced);
+
+    switch (dec->format) {
+        case SRCDECOMP_NONE: {
+            size_t size = in_size < out_size ? in_size : out_size;
+
+            if (size) memcpy(out, in, size);
+
+            *consumed = *produced = size;
+
+            return 0;
+        }
+
+#ifdef SRCDECOMP_WITH_GZIP
+        case SRCDECOMP_GZIP: {
+            z_stream *zs = (z_stream *)dec->codec;
+
+            /* zlib counts in uInt */
+            if (in_size  > UINT_MAX) in_size  = UINT_MAX;
+            if (out_size > UINT_MAX) out_size = UINT_MAX;
+
+            zs->next_in   = (Bytef *)in;
+            zs->avail_in  = (uInt)in_size;
+            zs->next_out  = (Bytef *)out;
+            zs->avail_out = (uInt)out_size;
+
+            int status = inflate(zs, Z_NO_FLUSH);
+
+            *consumed = in_size  - zs->avail_in;
+            *produced = out_size - zs->avail_out;
+
+            switch (status) {
+                case Z_STREAM_END:
+                    dec->frame_end = 1;
+
+                    /* no break */
+
+                case Z_OK:
+                case Z_BUF_ERROR:  /* no progress possible (not fatal) */
+                    return 0;
+
+                case Z_MEM_ERROR:
+                    return ENOMEM;
+            }
+
+            return EBADMSG;
+        }
+#endif
+
+#ifdef SRCDECOMP_WITH_ZSTD
+        case SRCDECOMP_ZSTD: {
+            ZSTD_inBuffer  zin  = { in,  in_size,  0 };
+            ZSTD_outBuffer zout = { out, out_size, 0 };
+
+            size_t status = ZSTD_decompressStream((ZSTD_DCtx *)dec->codec, &zout, &zin);
+
+            if (ZSTD_isError(status)) return EBADMSG;
+
+            *consumed = zin.pos;
+            *produced = zout.pos;
+
+            /* 0 means that a frame is completely decoded and flushed */
+            if (zin.pos || zout.pos)
+                dec->frame_end = 0 == status;
+
+            return 0;
+        }
+#endif
+
+        default:
+            break;
+    }
+
+    return ENOTSUP;
+}
+
+
+/**
+ *  \brief  Finalise decompressor
+ *
+ *  \param  dec  Decompressing source
+ */
+static void srcdecomp_codec_free(srcdecomp_t *dec) {
+    assert(NULL != dec);
+
+    if (NULL == dec->codec) return;
+
+    switch (dec->format) {
+#ifdef SRCDECOMP_WITH_GZIP
+        case SRCDECOMP_GZIP:
+
+            inflateEnd((z_stream *)dec->codec);
+            free(dec->codec);
+
+            break;
+#endif
+
+#ifdef SRCDECOMP_WITH_ZSTD
+        case SRCDECOMP_ZSTD:
+
+            ZSTD_freeDCtx((ZSTD_DCtx *)dec->codec);
+
+            break;
+#endif
+
+        default:
+            break;
+    }
+
+    dec->codec = NULL;
+}
+
+
+/**
+ *  \brief  Decompress output block
+ *
+ *  The output block is filled with decompressed data (the last block
+ *  may be shorter or even empty).
+ *  Input buffers are read (and released) as necessary.
+ *
+ *  \param  dec   Decompressing source
+ *  \param  slot  Decompressed block slot
+ */
+static void srcdecomp_fill(srcdecomp_t *dec, srcdecomp_slot_t *slot) {
+    assert(NULL != dec);
+    assert(NULL != slot);
+
+    memset(slot, 0, sizeof(srcdecomp_slot_t));
+
+    char *block = srcfile_block_pool_alloc(dec->pool);
+
+    if (NULL == block) {
+        slot->erno = ENOMEM;
+
+        return;
+    }
+
+    size_t size = 0;
+    int    erno = 0;
+
+    while (size < dec->block_size) {
+        const char *in      = NULL;
+        size_t      in_size = 0;
+
+        if (NULL != dec->input) {
+            in      = buffer_data(dec->input) + dec->input_pos;
+            in_size = buffer_size(dec->input) - dec->input_pos;
+        }
+
+        /* Input buffer exhausted */
+        if (0 == in_size && !dec->input_eof) {
+            erno = srcdecomp_read_input(dec);
+
+            if (erno) break;
+
+            continue;
+        }
+
+        /* Another compressed frame follows */
+        if (in_size && dec->frame_end) {
+            erno = srcdecomp_codec_reset(dec);
+
+            if (erno) break;
+        }
+
+        size_t consumed, produced;
+
+        erno = srcdecomp_codec_step(dec, in, in_size, &consumed,
+                                    block + size, dec->block_size - size, &produced);
+
+        if (erno) break;
+
+        dec->input_pos += consumed;
+        size           += produced;
+
+        /* No progress is possible (with output space available) */
+        if (0 == consumed && 0 == produced) {
+            /* Input is exhausted in the middle of a frame */
+            if (in_size || !dec->frame_end) {
+                erno = EBADMSG;
+
+                break;
+            }
+
+            slot->last = 1;
+
+            break;
+        }
+    }
+
+    if (erno) {
+        srcfile_block_pool_free(dec->pool, block, 0);
+
+        slot->erno = erno;
+
+        return;
+    }
+
+    slot->data = block;
+    slot->size = size;
+}
+
+
+/**
+ *  \brief  Decompression thread routine
+ *
+ *  The thread fills decompressed blocks and pushes them to the queue
+ *  until the last block is decompressed, an error occurs or it's
+ *  requested to stop.
+ *
+ *  \param  arg  Decompressing source
+ *
+ *  \return \c NULL
+ */
+static void *srcdecomp_routine(void *arg) {
+    srcdecomp_t *dec = (srcdecomp_t *)arg;
+
+    assert(NULL != dec);
+
+    for (;;) {
+        pthread_mutex_lock(&dec->mutex);
+
+        while (SRCDECOMP_QUEUE_SIZE == dec->queue_cnt && !dec->stop)
+            pthread_cond_wait(&dec->not_full, &dec->mutex);
+
+        int stop = dec->stop;
+
+        pthread_mutex_unlock(&dec->mutex);
+
+        if (stop) break;
+
+        srcdecomp_slot_t slot;
+
+        srcdecomp_fill(dec, &slot);
+
+        /* Push the block to queue */
+        pthread_mutex_lock(&dec->mutex);
+
+        dec->queue[(dec->queue_head + dec->queue_cnt) % SRCDECOMP_QUEUE_SIZE] = slot;
+
+        ++dec->queue_cnt;
+
+        pthread_cond_signal(&dec->not_empty);
+        pthread_mutex_unlock(&dec->mutex);
+
+        if (slot.last || slot.erno) break;
+    }
+
+    return NULL;
+}
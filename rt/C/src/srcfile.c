@@ -25,6 +25,11 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+/* O_DIRECT is a GNU extension */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "srcfile.h"
 
 #include <assert.h>
@@ -42,6 +47,12 @@
 /** Source file page size */
 #define srcfile_pagesize ((size_t)sysconf(_SC_PAGESIZE))
 
+/** Max. amount of cached blocks in private block pool */
+#define SRCFILE_BLOCK_CACHE_MAX 16
+
+/** Line segmentation block size (default) */
+#define SRCFILE_LINE_BLOCK_SIZE 65536
+
 
 /*
  * Static functions prototypes
@@ -53,10 +64,22 @@ static void srcfile_free_page(void *obj, char *page, size_t size);
 
 inline static int srcfile_get_block(srcfile_t *srcf, char **data, size_t *size);
 
-static void srcfile_free_block(void *obj, char *data, size_t size);
+inline static int srcfile_get_stream_block(srcfile_t *srcf, char **data, size_t *size);
 
 inline static int srcfile_get_line(srcfile_t *srcf, char **line, size_t *length);
 
+static int srcfile_read_line_block(srcfile_t *srcf, size_t size);
+
+static void srcfile_free_line(void *block, char *line, size_t length);
+
+static int srcfile_map(srcfile_t *srcf);
+
+static void srcfile_unmap(srcfile_map_t *map);
+
+inline static int srcfile_get_window(srcfile_t *srcf, char **window, size_t *size);
+
+static void srcfile_free_window(void *map, char *window, size_t size);
+
 
 /*
  * Interface definition
@@ -67,6 +90,104 @@ size_t srcfile_page_size(void) {
 }
 
 
+srcfile_block_pool_t *srcfile_block_pool_create(size_t block_size, size_t align, size_t cache_max) {
+    assert(0 < block_size);
+
+    srcfile_block_pool_t *pool = (srcfile_block_pool_t *)malloc(sizeof(srcfile_block_pool_t));
+
+    if (NULL == pool) return NULL;
+
+    objpool_init_aligned(&pool->blocks, block_size, align, cache_max, 0);
+
+    pthread_mutex_init(&pool->mutex, NULL);
+
+    pool->ref_cnt = 1;
+
+    return pool;
+}
+
+
+void srcfile_block_pool_release(srcfile_block_pool_t *pool) {
+    assert(NULL != pool);
+    assert(0 < pool->ref_cnt);
+
+    if (__atomic_sub_fetch(&pool->ref_cnt, 1, __ATOMIC_ACQ_REL)) return;
+
+    objpool_finalise(&pool->blocks);
+
+    pthread_mutex_destroy(&pool->mutex);
+
+    free(pool);
+}
+
+
+char *srcfile_block_pool_alloc(srcfile_block_pool_t *pool) {
+    assert(NULL != pool);
+
+    pthread_mutex_lock(&pool->mutex);
+
+    char *data = (char *)objpool_alloc(&pool->blocks);
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (NULL != data)
+        __atomic_add_fetch(&pool->ref_cnt, 1, __ATOMIC_RELAXED);
+
+    return data;
+}
+
+
+void srcfile_block_pool_free(void *pool, char *data, size_t size) {
+    srcfile_block_pool_t *block_pool = (srcfile_block_pool_t *)pool;
+
+    if (NULL == block_pool) {
+        free(data);
+
+        return;
+    }
+
+    pthread_mutex_lock(&block_pool->mutex);
+
+    objpool_free(&block_pool->blocks, data);
+
+    pthread_mutex_unlock(&block_pool->mutex);
+
+    srcfile_block_pool_release(block_pool);
+}
+
+
+int srcfile_set_block_pool(srcfile_t *srcf, srcfile_block_pool_t *pool, int direct_io) {
+    assert(NULL != srcf);
+    assert(NULL != pool);
+    assert(SRCFILE_SEG_BLOCK == srcf->segmode || SRCFILE_SEG_STREAM == srcf->segmode);
+    assert(-1 == srcf->fd);
+
+    size_t block_size = objpool_size(&pool->blocks);
+    size_t align      = objpool_align(&pool->blocks);
+
+    if (block_size < srcf->block_size) return EINVAL;
+
+    if (direct_io) {
+        if (SRCFILE_SEG_STREAM == srcf->segmode) return EINVAL;
+
+#ifndef O_DIRECT
+        return ENOTSUP;
+#endif
+        if (0 == align || block_size % align) return EINVAL;
+    }
+
+    __atomic_add_fetch(&pool->ref_cnt, 1, __ATOMIC_RELAXED);
+
+    if (NULL != srcf->block_pool)
+        srcfile_block_pool_release(srcf->block_pool);
+
+    srcf->block_pool = pool;
+    srcf->direct_io  = direct_io;
+
+    return 0;
+}
+
+
 void srcfile_create(srcfile_t *srcf, const char *filename, srcfile_segmode_t segmode, ...) {
     assert(NULL != srcf);
     assert(NULL != filename);
@@ -78,9 +199,9 @@ void srcfile_create(srcfile_t *srcf, const char *filename, srcfile_segmode_t seg
     assert('\0' == srcf->name[sizeof(srcf->name) - 1]);
     srcf->name[sizeof(srcf->name) - 1] = '\0';  /* if assert is empty */
 
-    srcf->segmode = segmode;
-    srcf->fd      = -1;
-    srcf->file    = NULL;
+    srcf->segmode   = segmode;
+    srcf->fd        = -1;
+    srcf->stream_fd = -1;
 
     va_list arg_list;
     va_start(arg_list, segmode);
@@ -108,7 +229,30 @@ void srcfile_create(srcfile_t *srcf, const char *filename, srcfile_segmode_t seg
         /* Line mode */
         case SRCFILE_SEG_LINE:
 
-            /* No arguments */
+            /* One argument: the block size lines are read by */
+            srcf->block_size = va_arg(arg_list, size_t);
+            if (0 == srcf->block_size)
+                srcf->block_size = SRCFILE_LINE_BLOCK_SIZE;
+
+            break;
+
+        /* Whole file mapping mode */
+        case SRCFILE_SEG_WHOLE:
+
+            /* Two arguments: window size multiplier & mapping flags */
+            srcf->window_size  = va_arg(arg_list, size_t);
+            srcf->window_size *= srcfile_pagesize;
+            srcf->map_flags    = va_arg(arg_list, int);
+
+            break;
+
+        /* Stream mode */
+        case SRCFILE_SEG_STREAM:
+
+            /* Two arguments: the block size & file descriptor */
+            srcf->block_size = va_arg(arg_list, size_t);
+            assert(srcf->block_size > 0);
+            srcf->stream_fd  = va_arg(arg_list, int);
 
             break;
     }
@@ -121,20 +265,41 @@ int srcfile_open(srcfile_t *srcf) {
     assert(NULL != srcf);
     assert(-1 == srcf->fd);
 
-    srcf->fd = open(srcf->name, O_RDONLY);
+    int flags = O_RDONLY;
+
+#ifdef O_DIRECT
+    if (srcf->direct_io)
+        flags |= O_DIRECT;
+#endif
+
+    srcf->fd = -1 != srcf->stream_fd ? srcf->stream_fd : open(srcf->name, flags);
+
+    /* Direct I/O isn't supported by the file system */
+    if (-1 == srcf->fd && EINVAL == errno && O_RDONLY != flags) {
+        srcf->direct_io = 0;
+
+        srcf->fd = open(srcf->name, O_RDONLY);
+    }
 
     if (-1 == srcf->fd) return errno;
 
-    /* In line mode, we need FILE-style access */
-    if (SRCFILE_SEG_LINE == srcf->segmode) {
-        srcf->file = fdopen(srcf->fd, "r");
+    /* In block & stream mode, data blocks are pooled */
+    if ((SRCFILE_SEG_BLOCK  == srcf->segmode ||
+         SRCFILE_SEG_STREAM == srcf->segmode) && NULL == srcf->block_pool)
+    {
+        srcf->block_pool = srcfile_block_pool_create(srcf->block_size, 0,
+                                                     SRCFILE_BLOCK_CACHE_MAX);
 
-        if (NULL == srcf->file) return errno;
+        if (NULL == srcf->block_pool) return ENOMEM;
     }
 
     /* Get file info */
     if (fstat(srcf->fd, &srcf->info)) return errno;
 
+    /* Map the whole file */
+    if (SRCFILE_SEG_WHOLE == srcf->segmode)
+        return srcfile_map(srcf);
+
     return 0;
 }
 
@@ -144,13 +309,30 @@ int srcfile_close(srcfile_t *srcf) {
 
     if (-1 == srcf->fd) return 0;
 
-    if (srcf->file) {
-        if (fclose(srcf->file)) return errno;
+    /* Release the mapping (buffers may still hold it) */
+    if (NULL != srcf->map) {
+        srcfile_unmap(srcf->map);
+
+        srcf->map = NULL;
     }
-    else {
-        if (close(srcf->fd)) return errno;
+
+    /* Release the block pool (buffers may still hold it) */
+    if (NULL != srcf->block_pool) {
+        srcfile_block_pool_release(srcf->block_pool);
+
+        srcf->block_pool = NULL;
+    }
+
+    /* Release the lines block (lines may still hold it) */
+    if (NULL != srcf->line_block) {
+        srcfile_free_line(srcf->line_block, NULL, 0);
+
+        srcf->line_block = NULL;
     }
 
+    /* Stream file descriptor isn't ours */
+    if (srcf->fd != srcf->stream_fd && close(srcf->fd)) return errno;
+
     srcf->fd = -1;
 
     return 0;
@@ -168,13 +350,16 @@ int srcfile_next_buffer(srcfile_t *srcf, buffer_t **buffer, int *last) {
     assert(NULL != srcf);
     assert(NULL != buffer);
 
-    /* No more data */
-    if (srcf->pos >= srcf->info.st_size) return ENODATA;
+    /* No more data (stream size is unknown in advance) */
+    if (SRCFILE_SEG_STREAM == srcf->segmode
+        ? srcf->eof
+        : srcf->pos >= srcf->info.st_size) return ENODATA;
 
     buffer_cleanup_fn *cleanup_fn;
+    void              *user_obj = NULL;
 
     char   *data;
-    size_t  size;
+    size_t  size = 0;
     int     erno;
 
     switch (srcf->segmode) {
@@ -192,7 +377,8 @@ int srcfile_next_buffer(srcfile_t *srcf, buffer_t **buffer, int *last) {
 
             erno = srcfile_get_block(srcf, &data, &size);
 
-            cleanup_fn = &srcfile_free_block;
+            cleanup_fn = &srcfile_block_pool_free;
+            user_obj   = srcf->block_pool;
 
             break;
 
@@ -201,7 +387,28 @@ int srcfile_next_buffer(srcfile_t *srcf, buffer_t **buffer, int *last) {
 
             erno = srcfile_get_line(srcf, &data, &size);
 
-            cleanup_fn = &srcfile_free_block;
+            cleanup_fn = &srcfile_free_line;
+            user_obj   = srcf->line_block;
+
+            break;
+
+        /* Whole file mapping mode */
+        case SRCFILE_SEG_WHOLE:
+
+            erno = srcfile_get_window(srcf, &data, &size);
+
+            cleanup_fn = &srcfile_free_window;
+            user_obj   = srcf->map;
+
+            break;
+
+        /* Stream mode */
+        case SRCFILE_SEG_STREAM:
+
+            erno = srcfile_get_stream_block(srcf, &data, &size);
+
+            cleanup_fn = &srcfile_block_pool_free;
+            user_obj   = srcf->block_pool;
 
             break;
 
@@ -213,11 +420,17 @@ int srcfile_next_buffer(srcfile_t *srcf, buffer_t **buffer, int *last) {
     if (erno) return erno;
 
     size_t new_pos = srcf->pos + size;
-    int    is_last = new_pos >= srcf->info.st_size;
+    int    is_last = SRCFILE_SEG_STREAM == srcf->segmode
+                   ? srcf->eof
+                   : new_pos >= srcf->info.st_size;
+
+    *buffer = buffer_create(data, size, cleanup_fn, user_obj, is_last);
 
-    *buffer = buffer_create(data, size, cleanup_fn, NULL, is_last);
+    if (NULL == *buffer) {
+        cleanup_fn(user_obj, data, size);
 
-    if (NULL == *buffer) return ENOMEM;
+        return ENOMEM;
+    }
 
     srcf->pos = new_pos;
 
@@ -279,9 +492,11 @@ static void srcfile_free_page(void *obj, char *page, size_t size) {
  *  \brief  Get data block from source file
  *
  *  The function provides block of source file.
- *  The data is read using \c pread.
+ *  The data is read using \c pread to a block from the file block pool.
  *  Max. size of data block read at once is specified on creation
  *  of the \c srcf object.
+ *  In direct I/O mode, whole pool block is always requested
+ *  (the read size must be aligned).
  *
  *  \param  srcf  Source file
  *  \param  data  Source block
@@ -301,8 +516,15 @@ inline static int srcfile_get_block(srcfile_t *srcf, char **data, size_t *size)
     if (*size > srcf->block_size)
         *size = srcf->block_size;
 
-    /* Allocate the data block */
-    *data = (char *)malloc(*size * sizeof(char));
+    srcfile_block_pool_t *pool = srcf->block_pool;
+
+    assert(NULL != pool);
+
+    if (srcf->direct_io)
+        *size = objpool_size(&pool->blocks);
+
+    /* Get the data block from pool */
+    *data = srcfile_block_pool_alloc(pool);
 
     if (NULL == *data) return ENOMEM;
 
@@ -311,7 +533,7 @@ inline static int srcfile_get_block(srcfile_t *srcf, char **data, size_t *size)
 
     if (-1 == *size) {
         int erno = errno;
-        free(*data);
+        srcfile_block_pool_free(pool, *data, 0);
         return erno;
     }
 
@@ -320,57 +542,325 @@ inline static int srcfile_get_block(srcfile_t *srcf, char **data, size_t *size)
 
 
 /**
- *  \brief  Dynamic data block cleanup callback
+ *  \brief  Get data block from source stream
  *
- *  \param  obj   User-specified object (not used)
- *  \param  data  Block of data (dynamicaly allocated)
- *  \param  size  Block size (irrelevant)
+ *  The function provides block of source stream.
+ *  The data is read using single \c read call (so it doesn't block
+ *  if any data is available) to a block from the file block pool.
+ *  If end of stream is reached, the block is empty and the end
+ *  of stream flag is set.
+ *
+ *  \param  srcf  Source file
+ *  \param  data  Source block
+ *  \param  size  Source block size
+ *
+ *  \retval 0       on success
+ *  \retval ENOMEM  on memory error
+ *  \retval errno   if \c read fails
  */
-static void srcfile_free_block(void *obj, char *data, size_t size) {
-    free(data);
+inline static int srcfile_get_stream_block(srcfile_t *srcf, char **data, size_t *size) {
+    assert(NULL != srcf);
+    assert(NULL != data);
+    assert(NULL != size);
+
+    srcfile_block_pool_t *pool = srcf->block_pool;
+
+    assert(NULL != pool);
+
+    /* Get the data block from pool */
+    *data = srcfile_block_pool_alloc(pool);
+
+    if (NULL == *data) return ENOMEM;
+
+    /* Read available data from stream */
+    ssize_t rsize;
+
+    do {
+        rsize = read(srcf->fd, *data, srcf->block_size);
+
+    } while (-1 == rsize && EINTR == errno);
+
+    if (-1 == rsize) {
+        int erno = errno;
+        srcfile_block_pool_free(pool, *data, 0);
+        return erno;
+    }
+
+    *size = (size_t)rsize;
+
+    if (0 == *size)
+        srcf->eof = 1;
+
+    return 0;
 }
 
 
 /**
  *  \brief  Get line from source file
  *
- *  The function reads another line of source from the file.
- *  \c getline is used to recover the line and resolve its end.
+ *  The function provides another line of source as a slice
+ *  of the current lines block (the line references the block).
+ *  Line end is found by \c memchr.
+ *  If the line isn't complete in the block, new block is read
+ *  from the line begin (at least twice as large as the line part,
+ *  so that long lines are read in logarithmic number of steps).
+ *  The last line may not be ended.
  *
  *  \param  srcf    Source file
  *  \param  line    Source line
  *  \param  length  Source line length
  *
  *  \retval 0       on success
- *  \retval errno   if \c fseek or \c getline fails
+ *  \retval ENOMEM  on memory error
+ *  \retval errno   if \c pread fails
  */
 inline static int srcfile_get_line(srcfile_t *srcf, char **line, size_t *length) {
     assert(NULL != srcf);
     assert(NULL != line);
     assert(NULL != length);
 
-    /*
-     * Make sure the position is correct
-     * Note that this isn't necessary unless
-     * the position is changed otherwise than
-     * by getline itself
-     */
-    if (fseek(srcf->file, srcf->pos, SEEK_SET)) return errno;
+    size_t block_size = srcf->block_size;
+
+    for (;;) {
+        srcfile_line_block_t *block = srcf->line_block;
+
+        /* Look for the line end in the current block */
+        if (NULL != block && block->pos <= srcf->pos &&
+            srcf->pos < block->pos + block->size)
+        {
+            char   *begin = block->data + (srcf->pos - block->pos);
+            size_t  avail = block->size - (srcf->pos - block->pos);
+            char   *end   = (char *)memchr(begin, '\n', avail);
+
+            /* Line end found or the block reaches EoF */
+            if (NULL != end ||
+                block->pos + block->size >= (size_t)srcf->info.st_size)
+            {
+                *line   = begin;
+                *length = NULL != end ? (size_t)(end - begin) + 1 : avail;
+
+                __atomic_add_fetch(&block->ref_cnt, 1, __ATOMIC_RELAXED);
+
+                return 0;
+            }
+
+            /* Incomplete line, next block must be larger than the rest */
+            if (block_size < 2 * avail)
+                block_size = 2 * avail;
+        }
+
+        int erno = srcfile_read_line_block(srcf, block_size);
+
+        if (erno) return erno;
+    }
+}
+
+
+/**
+ *  \brief  Read lines block from source file
+ *
+ *  The block is read from current position in the file.
+ *  It replaces the current block (its reference is released).
+ *
+ *  \param  srcf  Source file
+ *  \param  size  Block size
+ *
+ *  \retval 0       on success
+ *  \retval ENOMEM  on memory error
+ *  \retval EIO     if the file was truncated
+ *  \retval errno   if \c pread fails
+ */
+static int srcfile_read_line_block(srcfile_t *srcf, size_t size) {
+    assert(NULL != srcf);
+
+    /* Block size */
+    if (size > srcf->info.st_size - srcf->pos)
+        size = srcf->info.st_size - srcf->pos;
+
+    srcfile_line_block_t *block = (srcfile_line_block_t *)malloc(
+        sizeof(srcfile_line_block_t) + size);
+
+    if (NULL == block) return ENOMEM;
+
+    block->data    = (char *)(block + 1);
+    block->size    = 0;
+    block->pos     = srcf->pos;
+    block->ref_cnt = 1;
+
+    /* Read the data from file (pread may read less) */
+    while (block->size < size) {
+        ssize_t rsize = pread(srcf->fd, block->data + block->size,
+                              size - block->size, block->pos + block->size);
+
+        if (0 >= rsize) {
+            int erno = rsize ? errno : EIO;
+            free(block);
+            return erno;
+        }
+
+        block->size += (size_t)rsize;
+    }
+
+    /* Replace the current block */
+    if (NULL != srcf->line_block)
+        srcfile_free_line(srcf->line_block, NULL, 0);
+
+    srcf->line_block = block;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Line cleanup callback
+ *
+ *  Releases the line lines block reference.
+ *  The block is freed with the last reference.
+ *
+ *  \param  block   Lines block
+ *  \param  line    Line (irrelevant)
+ *  \param  length  Line length (irrelevant)
+ */
+static void srcfile_free_line(void *block, char *line, size_t length) {
+    srcfile_line_block_t *line_block = (srcfile_line_block_t *)block;
+
+    assert(NULL != line_block);
+    assert(0 < line_block->ref_cnt);
+
+    if (__atomic_sub_fetch(&line_block->ref_cnt, 1, __ATOMIC_ACQ_REL)) return;
+
+    free(line_block);
+}
+
 
-    /* Read another line from source file */
-    *line = NULL;
+/**
+ *  \brief  Map the whole source file to memory
+ *
+ *  The mapping is advised for sequential access and read-ahead;
+ *  optionally, it's pre-faulted and/or transparent huge pages
+ *  are requested (if supported).
+ *  The source file holds the mapping reference.
+ *
+ *  \param  srcf  Source file
+ *
+ *  \retval 0       on success
+ *  \retval ENOMEM  on memory error
+ *  \retval errno   if \c mmap fails
+ */
+static int srcfile_map(srcfile_t *srcf) {
+    assert(NULL != srcf);
+    assert(NULL == srcf->map);
+
+    /* Empty file can't be mapped (and needn't be) */
+    if (0 == srcf->info.st_size) return 0;
+
+    srcfile_map_t *map = (srcfile_map_t *)malloc(sizeof(srcfile_map_t));
 
-    ssize_t rlength = getline(line, length, srcf->file);
+    if (NULL == map) return ENOMEM;
 
-    if (-1 == rlength) return errno;
+    int mmap_flags = MAP_PRIVATE | MAP_NORESERVE;
 
-    assert(0 <= rlength);
+#ifdef MAP_POPULATE
+    if (srcf->map_flags & SRCFILE_MAP_POPULATE)
+        mmap_flags |= MAP_POPULATE;
+#endif
 
-    /*
-     * Note that *length is size of allocated buffer from getline, here
-     * (which may and does differ from line length)
-     */
-    *length = (size_t)rlength;
+    map->size    = (size_t)srcf->info.st_size;
+    map->ref_cnt = 1;
+    map->data    = (char *)mmap(NULL, map->size, PROT_READ, mmap_flags, srcf->fd, 0);
+
+    if (MAP_FAILED == map->data) {
+        int erno = errno;
+        free(map);
+        return erno;
+    }
+
+    /* Advices are just hints, failures are ignored */
+    madvise(map->data, map->size, MADV_SEQUENTIAL);
+    madvise(map->data, map->size, MADV_WILLNEED);
+
+#ifdef MADV_HUGEPAGE
+    if (srcf->map_flags & SRCFILE_MAP_HUGEPAGES)
+        madvise(map->data, map->size, MADV_HUGEPAGE);
+#endif
+
+    srcf->map = map;
 
     return 0;
 }
+
+
+/**
+ *  \brief  Release source file mapping reference
+ *
+ *  The file is unmapped with the last reference.
+ *
+ *  \param  map  Source file mapping
+ */
+static void srcfile_unmap(srcfile_map_t *map) {
+    assert(NULL != map);
+    assert(0 < map->ref_cnt);
+
+    if (__atomic_sub_fetch(&map->ref_cnt, 1, __ATOMIC_ACQ_REL)) return;
+
+    munmap(map->data, map->size);
+
+    free(map);
+}
+
+
+/**
+ *  \brief  Get source file mapping window
+ *
+ *  The function provides next window of the whole file mapping
+ *  (or the rest of the file if window size is 0).
+ *  No system call takes place; the window references the mapping.
+ *
+ *  \param  srcf    Source file
+ *  \param  window  Mapping window
+ *  \param  size    Mapping window size
+ *
+ *  \retval 0       on success
+ *  \retval EBADF   if the file isn't mapped (not open)
+ */
+inline static int srcfile_get_window(srcfile_t *srcf, char **window, size_t *size) {
+    assert(NULL != srcf);
+    assert(NULL != window);
+    assert(NULL != size);
+
+    if (NULL == srcf->map) return EBADF;
+
+    /* Window size */
+    *size = srcf->info.st_size - srcf->pos;
+    if (srcf->window_size && *size > srcf->window_size)
+        *size = srcf->window_size;
+
+    *window = srcf->map->data + srcf->pos;
+
+    __atomic_add_fetch(&srcf->map->ref_cnt, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Mapping window cleanup callback
+ *
+ *  Pages of the window are dropped (the mapping is private
+ *  and read-only, so they'd be re-read from the file if accessed
+ *  again).
+ *  Then, the mapping reference is released.
+ *
+ *  \param  map     Source file mapping
+ *  \param  window  Mapping window
+ *  \param  size    Mapping window size
+ */
+static void srcfile_free_window(void *map, char *window, size_t size) {
+    srcfile_map_t *srcf_map = (srcfile_map_t *)map;
+
+    /* Window (but the whole file) is released before the mapping */
+    if (size < srcf_map->size)
+        madvise(window, size, MADV_DONTNEED);
+
+    srcfile_unmap(srcf_map);
+}
@@ -218,6 +218,53 @@ static void sa_stack_destroy(sa_stack_t *stack) {
 }
 
 
+/*
+ * Semantic values stack interface
+ */
+
+/**
+ *  \brief  Push value to semantic values stack
+ *
+ *  \param  stack  Stack
+ *  \param  value  Value
+ *
+ *  \retval 0      on success
+ *  \retval ENOMEM on memory error
+ */
+inline static int sa_value_stack_push(sa_value_stack_t *stack, void *value) {
+    assert(NULL != stack);
+
+    /* Increase capacity */
+    if (!(stack->depth < stack->cap)) {
+        size_t cap = stack->cap + SA_STACK_CAP_UNIT;
+
+        void **impl = (void **)realloc(stack->impl, cap * sizeof(void *));
+
+        if (NULL == impl) return ENOMEM;
+
+        stack->impl = impl;
+        stack->cap  = cap;
+    }
+
+    stack->impl[stack->depth++] = value;
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Destroy semantic value
+ *
+ *  \param  sa     Syntax analyser
+ *  \param  value  Value
+ */
+#define sa_value_destroy(sa, value) \
+    do { \
+        if (NULL != (value) && NULL != (sa)->value_tab->destroy) \
+            (sa)->value_tab->destroy((value), (sa)->value_obj); \
+    } while (0)
+
+
 /*
  * Parse tree constructors wrappers
  * (checking if parse tree construction is enabled)
@@ -274,6 +321,8 @@ static void sa_stack_destroy(sa_stack_t *stack) {
  * Static functions declarations
  */
 
+static sa_status_t sa_read_action(syxa_t *sa, size_t state, sa_action_t *action, const la_item_t **item, size_t *item_cnt);
+
 static sa_status_t sa_act_on_input(syxa_t *sa);
 
 inline static void sa_ptree_add_node(syxa_t *sa, ptree_node_t *node);
@@ -284,6 +333,16 @@ static sa_status_t sa_ptree_add_ntnode_impl(syxa_t *sa, const grammar_rule_t *ru
 
 static sa_status_t sa_ptree_complete_impl(syxa_t *sa);
 
+static sa_status_t sa_shift_value(syxa_t *sa, const la_item_t *item);
+
+static sa_status_t sa_reduce_value(syxa_t *sa, const grammar_rule_t *rule);
+
+static sa_status_t sa_push_event(syxa_t *sa, sa_event_type_t type, size_t rule, const la_item_t *item);
+
+static sa_status_t sa_flush_events(syxa_t *sa);
+
+static void sa_clear_events(syxa_t *sa);
+
 static void sa_ptree_cleanup(syxa_t *sa);
 
 
@@ -341,6 +400,17 @@ syxa_t *sa_create(syxa_t                 *sa,
 
     sa->state.accept = 0;
 
+    /* Semantic values are disabled (see sa_set_value_tab) */
+    sa->value_tab = NULL;
+    sa->value_obj = NULL;
+
+    /* Parsing events are disabled (see sa_set_event_handler) */
+    sa->event_fn  = NULL;
+    sa->event_obj = NULL;
+    sa->events    = NULL;
+    sa->event_cap = 0;
+    sa->event_cnt = 0;
+
     /* Initialise parse tree creation */
     sa->ptree = ptree_enabled;
     sa->state.ptree = NULL;
@@ -348,6 +418,11 @@ syxa_t *sa_create(syxa_t                 *sa,
     /* Create lexical analyser */
     la_create(&sa->la, la_fsa, items_total);
 
+    /* Input is read by the lexical analyser */
+    sa->input_items = NULL;
+    sa->input_cnt   = 0;
+    sa->input_code  = LEXIG_INVALID;
+
     /* Set parser tables */
     sa->action_tab = action_tab;
     sa->goto_tab   = goto_tab;
@@ -369,6 +444,22 @@ void sa_destroy(syxa_t *sa) {
     /* Destroy parse tree (if any) */
     sa_ptree_cleanup(sa);
 
+    /* Destroy semantic values */
+    if (sa_values_enabled(sa)) {
+        sa_value_stack_t *stack = &sa->state.value_stack;
+
+        while (stack->depth) {
+            void *value = stack->impl[--stack->depth];
+
+            sa_value_destroy(sa, value);
+        }
+
+        free(stack->impl);
+    }
+
+    /* Drop undelivered events */
+    if (sa_events_enabled(sa)) sa_clear_events(sa);
+
     /* Destroy lexical analyser */
     la_destroy(&sa->la);
 
@@ -392,19 +483,272 @@ sa_status_t sa_add_data(syxa_t *sa, char *data, size_t size, buffer_cleanup_fn *
 }
 
 
+int sa_set_value_tab(syxa_t *sa, const sa_value_tab_t *value_tab, void *user_obj) {
+    assert(NULL != sa);
+    assert(NULL != value_tab);
+    assert(!sa_values_enabled(sa));
+
+    /* Parsing mustn't have begun */
+    assert(1 == sa_stack_depth(&sa->state.pda_stack));
+
+    sa_value_stack_t *stack = &sa->state.value_stack;
+
+    stack->impl = (void **)malloc(SA_STACK_CAP_UNIT * sizeof(void *));
+
+    if (NULL == stack->impl) return ENOMEM;
+
+    stack->depth = 0;
+    stack->cap   = SA_STACK_CAP_UNIT;
+
+    sa->value_tab = value_tab;
+    sa->value_obj = user_obj;
+
+    return 0;
+}
+
+
+void sa_set_event_handler(syxa_t *sa, sa_event_fn *handler, void *user_obj, sa_event_t *ring, size_t ring_size) {
+    assert(NULL != sa);
+    assert(NULL != handler);
+    assert((NULL == ring) == (0 == ring_size));
+
+    /* Parsing mustn't have begun */
+    assert(1 == sa_stack_depth(&sa->state.pda_stack));
+
+    sa->event_fn  = handler;
+    sa->event_obj = user_obj;
+    sa->event_cnt = 0;
+
+    /* Deliver each event as it happens */
+    if (NULL == ring) {
+        ring      = &sa->event;
+        ring_size = 1;
+    }
+
+    sa->events    = ring;
+    sa->event_cap = ring_size;
+}
+
+
+void sa_set_items(syxa_t *sa, const la_item_t *items, size_t item_cnt) {
+    assert(NULL != sa);
+    assert(NULL != items || 0 == item_cnt);
+
+    sa->input_items = items;
+    sa->input_cnt   = item_cnt;
+}
+
+
 sa_status_t sa_parse(syxa_t *sa) {
+    assert(NULL != sa);
+
+    /* Input was accepted already (the same for both parser forms) */
+    if (sa_accept(sa)) return SA_OK;
+
     sa_status_t status = SA_OK;
 
-    while (!sa_accept(sa)) {
+    /* Direct-coded parser */
+    sa_direct_parse_fn *parse = sa_action_table_parse(sa->action_tab);
+
+    if (NULL != parse)
+        status = parse(sa);
+
+    else while (!sa_accept(sa)) {
         status = sa_act_on_input(sa);
 
         if (SA_OK != status) break;
     }
 
+    /* Deliver pending events */
+    if (sa_events_enabled(sa) && sa->event_cnt &&
+        SA_OK != sa_flush_events(sa))
+    {
+        status = sa->status = SA_ERROR;
+    }
+
     return status;
 }
 
 
+sa_status_t sa_read_items(syxa_t *sa, const la_item_t **items, size_t *item_cnt) {
+    assert(NULL != sa);
+    assert(NULL != items);
+    assert(NULL != item_cnt);
+
+    la_status_t la_status = LA_OK;
+
+    /* Lexical items are fed by user (alternatives share offset) */
+    if (NULL != sa->input_items) {
+        *items    = sa->input_items;
+        *item_cnt = 0;
+
+        while (*item_cnt < sa->input_cnt &&
+            la_item_token_offset(*items + *item_cnt) ==
+            la_item_token_offset(*items))
+        {
+            ++*item_cnt;
+        }
+
+        if (0 == *item_cnt) la_status = LA_INPUT_EXHAUSTED;
+    }
+
+    else
+        la_status = la_get_items(&sa->la, items, item_cnt);
+
+    switch (la_status) {
+        case LA_OK:
+            assert(0 < *item_cnt);
+
+            return sa->status = SA_OK;
+
+        case LA_INPUT_EXHAUSTED:
+            return sa->status = SA_INPUT_EXHAUSTED;
+
+        case LA_INPUT_INVALID:
+            return sa->status = SA_SYNTAX_ERROR;
+
+        case LA_ERROR:
+            break;
+    }
+
+    return sa->status = SA_ERROR;
+}
+
+
+sa_status_t sa_shift(syxa_t *sa, size_t next_state, const la_item_t *item, size_t item_cnt) {
+    assert(NULL != sa);
+    assert(NULL != item);
+
+    if (sa_stack_push(&sa->state.pda_stack, next_state))
+        return sa->status = SA_ERROR;
+
+    sa->status = SA_OK;
+
+    /* Shift event */
+    if (sa_events_enabled(sa) &&
+        SA_OK != sa_push_event(sa, SA_EVENT_SHIFT, 0, item))
+    {
+        return sa->status = SA_ERROR;
+    }
+
+    /* Terminal symbol semantic value */
+    if (sa_values_enabled(sa) && SA_OK != sa_shift_value(sa, item))
+        return sa->status = SA_ERROR;
+
+    /* Add another parse tree terminal leaf */
+    sa_ptree_add_tnode(sa, item);
+
+    /* Consume (aka shift) lexical item on the input head */
+    int item_code = la_item_code(item);
+
+    if (NULL != sa->input_items) {
+        sa->input_items += item_cnt;
+        sa->input_cnt   -= item_cnt;
+        sa->input_code   = item_code;
+    }
+    else
+        la_read_item(&sa->la, item_code);
+
+    return sa->status;
+}
+
+
+sa_status_t sa_reduce(syxa_t *sa, const grammar_rule_t *rule, size_t *state) {
+    assert(NULL != sa);
+    assert(NULL != rule);
+    assert(NULL != state);
+
+    /* Remember reduction path */
+    if (sa->reduct_log) {
+        int stack_status = sa_stack_push(&sa->state.reduct_stack,
+                               grammar_rule_no(rule));
+
+        switch (stack_status) {
+            case 0:
+                /* OK */
+                break;
+
+            case EOVERFLOW:
+                /* Reduction too long */
+
+                /* Fall-through to the default branch is intentional */
+
+            default:
+                /* Something sinister (memory fault or so) */
+                return sa->status = SA_ERROR;
+        }
+    }
+
+    /* Reduce event */
+    if (sa_events_enabled(sa) &&
+        SA_OK != sa_push_event(sa, SA_EVENT_REDUCE, grammar_rule_no(rule), NULL))
+    {
+        return sa->status = SA_ERROR;
+    }
+
+    /* Left-hand side symbol semantic value */
+    if (sa_values_enabled(sa) && SA_OK != sa_reduce_value(sa, rule))
+        return sa->status = SA_ERROR;
+
+    /* Pop |X| states from stack */
+    sa_stack_pop(&sa->state.pda_stack, grammar_rule_rhs_symbol_count(rule));
+
+    *state = sa_stack_get_top(&sa->state.pda_stack);
+
+    sa->status = SA_OK;
+
+    /* Add non-terminal node to parse tree */
+    sa_ptree_add_ntnode(sa, rule);
+
+    return sa->status;
+}
+
+
+sa_status_t sa_goto(syxa_t *sa, size_t next_state) {
+    assert(NULL != sa);
+
+    switch (sa_stack_push(&sa->state.pda_stack, next_state)) {
+        case 0:
+            /* OK */
+            return sa->status = SA_OK;
+
+        case EOVERFLOW:
+            /*
+             * Stack too deep
+             *
+             * This almost definitely means deep grammar recursion;
+             * either the input is very wierd or someone is deliberately
+             * playing dirty with us...
+             * Anyway, we shall stop it right now.
+             */
+
+            /* Fall-through to the default branch is intentional */
+
+        default:
+            /* Something sinister (memory fault or so) */
+            return sa->status = SA_ERROR;
+    }
+}
+
+
+sa_status_t sa_accept_input(syxa_t *sa) {
+    assert(NULL != sa);
+
+    sa_stack_pop(&sa->state.pda_stack, 1);
+
+    assert(1 == sa_stack_depth(&sa->state.pda_stack));
+    assert(0 == sa_stack_get_top(&sa->state.pda_stack));
+
+    sa->state.accept = 1;
+    sa->status       = SA_OK;
+
+    /* Parse tree finishing touches */
+    sa_ptree_complete(sa);
+
+    return sa->status;
+}
+
+
 size_t *sa_derivation(syxa_t *sa, size_t *derivation_len) {
     assert(NULL != sa);
     assert(NULL != derivation_len);
@@ -440,16 +784,76 @@ ptree_node_t *sa_handover_ptree(syxa_t *sa) {
 }
 
 
+void *sa_handover_value(syxa_t *sa) {
+    assert(NULL != sa);
+
+    if (!sa_accept(sa) || !sa_values_enabled(sa)) return NULL;
+
+    sa_value_stack_t *stack = &sa->state.value_stack;
+
+    /* Already handed over */
+    if (0 == stack->depth) return NULL;
+
+    /* Root symbol value is the only one left */
+    assert(1 == stack->depth);
+
+    return stack->impl[--stack->depth];
+}
+
+
 /*
  * Static functions
  */
 
+/**
+ *  \brief  Get action by the lexical item(s) on the input head
+ *
+ *  If there are more lexical item alternatives on the input head,
+ *  the 1st one with an action defined is chosen.
+ *
+ *  \param[in]   sa        Syntax analyser
+ *  \param[in]   state     Current state
+ *  \param[out]  action    Action
+ *  \param[out]  item      Lexical item chosen
+ *  \param[out]  item_cnt  Lexical items count (on the input head)
+ *
+ *  \retval SA_OK              if action was obtained (reject, maybe)
+ *  \retval SA_INPUT_EXHAUSTED if input is exhausted
+ *  \retval SA_SYNTAX_ERROR    if there is a lexical error in the input
+ *  \retval SA_ERROR           on other failure
+ */
+static sa_status_t sa_read_action(syxa_t *sa, size_t state, sa_action_t *action, const la_item_t **item, size_t *item_cnt) {
+    assert(NULL != sa);
+
+    /* Get lexical item(s) on the input head */
+    const la_item_t *items;
+
+    sa_status_t status = sa_read_items(sa, &items, item_cnt);
+
+    if (SA_OK != status) return status;
+
+    /* Get action from action table (currect state / input head) */
+    size_t item_idx = 0;
+
+    do {
+        *item = items + item_idx++;
+
+        *action = sa_action_table_at(sa->action_tab, state, la_item_code(*item));
+
+    } while (SA_ACTION_REJECT == sa_action_type(*action) && item_idx < *item_cnt);
+
+    return SA_OK;
+}
+
+
 /**
  *  \brief  Perform one action
  *
  *  The function tries to get next lexical item from the input.
  *  if (one or more) lexical item(s) may be provided,
  *  the function acts on it as defined by the LR parser action table.
+ *  Default reductions (see \ref sa_action_table_default) are done
+ *  without reading the input.
  *
  *  After the function is called, either the parser state stays intact
  *  (on input exhaustion) or it changes (as prescribed in the parser
@@ -465,136 +869,42 @@ ptree_node_t *sa_handover_ptree(syxa_t *sa) {
 static sa_status_t sa_act_on_input(syxa_t *sa) {
     assert(NULL != sa);
 
-    /* Get lexical item(s) on the input head */
-    const la_item_t *items;
-    size_t           item_cnt;
-
-    la_status_t la_status = la_get_items(&sa->la, &items, &item_cnt);
-
-    switch (la_status) {
-        case LA_OK:
-            assert(0 < item_cnt);
-
-            sa->status = SA_OK;
-
-            break;
-
-        case LA_INPUT_EXHAUSTED:
-            return sa->status = SA_INPUT_EXHAUSTED;
-
-        case LA_INPUT_INVALID:
-            return sa->status = SA_SYNTAX_ERROR;
-
-        case LA_ERROR:
-            return sa->status = SA_ERROR;
-    }
-
     /* Get current state */
     size_t state = sa_stack_get_top(&sa->state.pda_stack);
 
-    /* Get action from action table (currect state / input head) */
-    const sa_action_t *action    = NULL;
-    const la_item_t   *item      = NULL;
-    size_t             item_idx  = 0;
-    int                item_code;
-
-    assert(item_idx < item_cnt);
+    /* Default reduction (no need to look ahead) */
+    sa_action_t      action   = sa_action_table_default(sa->action_tab, state);
+    const la_item_t *item     = NULL;
+    size_t           item_cnt = 0;
 
-    do {
-        item = items + item_idx++;
-
-        item_code = la_item_code(item);
+    sa->status = SA_OK;
 
-        action = sa_action_table_at(sa->action_tab, state, item_code);
+    if (SA_ACTION_REJECT == sa_action_type(action)) {
+        sa_status_t status = sa_read_action(sa, state, &action, &item, &item_cnt);
 
-    } while (NULL == action && item_idx < item_cnt);
+        if (SA_OK != status) return sa->status = status;
+    }
 
     /* Perform selected action */
     switch (sa_action_type(action)) {
-        case SA_ACTION_SHIFT: {
+        case SA_ACTION_SHIFT:
             /* Next state is defined in the action */
-            size_t next_state = sa_action_shift_next_state(action);
-
-            sa_stack_push(&sa->state.pda_stack, next_state);
-
-            /* Add another parse tree terminal leaf */
-            sa_ptree_add_tnode(sa, item);
-
-            /* Consume (aka shift) lexical item on the input head */
-            la_read_item(&sa->la, item_code);
-
-            break;
-        }
+            return sa_shift(sa, sa_action_shift_next_state(action), item, item_cnt);
 
         case SA_ACTION_REDUCE: {
-            int stack_status;
-
             /* Get reduce rule A => X */
             size_t rule_no = sa_action_reduce_rule_no(action);
             const grammar_rule_t *rule = sa_rule_table_at(sa->rule_tab, rule_no);
 
-            /* Remember reduction path */
-            if (sa->reduct_log) {
-                stack_status = sa_stack_push(&sa->state.reduct_stack, rule_no);
-
-                switch (stack_status) {
-                    case 0:
-                        /* OK */
-                        break;
-
-                    case EOVERFLOW:
-                        /* Reduction too long */
-
-                        /* Fall-through to the default branch is intentional */
-
-                    default:
-                        /* Something sinister (memory fault or so) */
-                        return sa->status = SA_ERROR;
-                }
-            }
-
-            /* Pop |X| states from stack (plus current top) */
-            size_t rhs_sym_cnt = grammar_rule_rhs_symbol_count(rule);
-
-            sa_stack_pop(&sa->state.pda_stack, rhs_sym_cnt);
+            if (SA_OK != sa_reduce(sa, rule, &state)) return sa->status;
 
             /* Next state is defined in goto table (by current stack top and NT A) */
-            state = sa_stack_get_top(&sa->state.pda_stack);
-
             int    lhs_nt     = grammar_rule_lhs_non_terminal(rule);
             size_t next_state = sa_goto_table_at(sa->goto_tab, state, lhs_nt);
 
-            assert(SA_NULL_TARGET != next_state);
-
-            stack_status = sa_stack_push(&sa->state.pda_stack, next_state);
-
-            switch (stack_status) {
-                case 0:
-                    /* OK */
-                    break;
-
-                case EOVERFLOW:
-                    /*
-                     * Stack too deep
-                     *
-                     * This almost definitely means deep grammar recursion;
-                     * either the input is very wierd or someone is deliberately
-                     * playing dirty with us...
-                     * Anyway, we shall stop it right now.
-                     */
-                    sa->status = SA_ERROR;
-
-                    break;
+            assert(sa_goto_table_null_target(sa->goto_tab) != next_state);
 
-                default:
-                    /* Something sinister (memory fault or so) */
-                    sa->status = SA_ERROR;
-            }
-
-            /* Add non-terminal node to parse tree */
-            sa_ptree_add_ntnode(sa, rule);
-
-            break;
+            return sa_goto(sa, next_state);
         }
 
         case SA_ACTION_ACCEPT:
@@ -604,19 +914,9 @@ static sa_status_t sa_act_on_input(syxa_t *sa) {
              * Accept action is de-facto augmented grammar
              * root reduce action on EOF (with no next state).
              */
-            assert(LEXIG_EOF == item_code);
-
-            sa_stack_pop(&sa->state.pda_stack, 1);
-
-            assert(1 == sa_stack_depth(&sa->state.pda_stack));
-            assert(0 == sa_stack_get_top(&sa->state.pda_stack));
+            assert(LEXIG_EOF == la_item_code(item));
 
-            sa->state.accept = 1;
-
-            /* Parse tree finishing touches */
-            sa_ptree_complete(sa);
-
-            break;
+            return sa_accept_input(sa);
 
         case SA_ACTION_REJECT:
             sa->status = SA_SYNTAX_ERROR;
@@ -813,6 +1113,162 @@ static sa_status_t sa_ptree_complete_impl(syxa_t *sa) {
 }
 
 
+/**
+ *  \brief  Push shifted terminal symbol semantic value
+ *
+ *  \param  sa    Syntax analyser
+ *  \param  item  Lexical item shifted
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (value constructor or memory error)
+ */
+static sa_status_t sa_shift_value(syxa_t *sa, const la_item_t *item) {
+    assert(NULL != sa);
+    assert(sa_values_enabled(sa));
+
+    void *value = NULL;
+
+    sa_shift_value_fn *shift = sa->value_tab->shift;
+
+    if (NULL != shift && shift(&value, item, sa->value_obj))
+        return SA_ERROR;
+
+    if (sa_value_stack_push(&sa->state.value_stack, value)) {
+        sa_value_destroy(sa, value);
+
+        return SA_ERROR;
+    }
+
+    return SA_OK;
+}
+
+
+/**
+ *  \brief  Replace rule right-hand side semantic values by left-hand side one
+ *
+ *  \param  sa    Syntax analyser
+ *  \param  rule  Grammar rule
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (reduce callback or memory error)
+ */
+static sa_status_t sa_reduce_value(syxa_t *sa, const grammar_rule_t *rule) {
+    assert(NULL != sa);
+    assert(sa_values_enabled(sa));
+
+    sa_value_stack_t *stack = &sa->state.value_stack;
+
+    size_t rule_no = grammar_rule_no(rule);
+    size_t rhs_cnt = grammar_rule_rhs_symbol_count(rule);
+
+    assert(rhs_cnt <= stack->depth);
+
+    sa_reduce_value_fn *reduce = rule_no < sa->value_tab->rule_cnt
+                               ? sa->value_tab->reduce[rule_no] : NULL;
+
+    /* Right-hand side values are passed over (still in place) */
+    stack->depth -= rhs_cnt;
+
+    void **rhs   = stack->impl + stack->depth;
+    void  *value = NULL;
+
+    if (NULL != reduce) {
+        if (reduce(&value, rhs, sa->value_obj)) return SA_ERROR;
+    }
+
+    /* Default: $$ = $1 */
+    else if (0 < rhs_cnt) {
+        value = rhs[0];
+
+        size_t i = 1;
+
+        for (; i < rhs_cnt; ++i)
+            sa_value_destroy(sa, rhs[i]);
+    }
+
+    if (sa_value_stack_push(stack, value)) {
+        sa_value_destroy(sa, value);
+
+        return SA_ERROR;
+    }
+
+    return SA_OK;
+}
+
+
+/**
+ *  \brief  Add parsing event
+ *
+ *  The event is added to the pending events; the events are delivered
+ *  if the ring is full.
+ *
+ *  \param  sa    Syntax analyser
+ *  \param  type  Event type
+ *  \param  rule  Grammar rule number (reduce event)
+ *  \param  item  Lexical item shifted (shift event)
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (events handler error)
+ */
+static sa_status_t sa_push_event(syxa_t *sa, sa_event_type_t type, size_t rule, const la_item_t *item) {
+    assert(NULL != sa);
+    assert(sa_events_enabled(sa));
+    assert(sa->event_cnt < sa->event_cap);
+
+    sa_event_t *event = sa->events + sa->event_cnt++;
+
+    event->type = type;
+    event->rule = rule;
+
+    /* The item copy only references the source buffer(s) */
+    if (SA_EVENT_SHIFT == type) la_item_copy(&event->item, item);
+
+    if (sa->event_cnt < sa->event_cap) return SA_OK;
+
+    return sa_flush_events(sa);
+}
+
+
+/**
+ *  \brief  Deliver pending parsing events
+ *
+ *  The events are dropped even if the handler fails.
+ *
+ *  \param  sa  Syntax analyser
+ *
+ *  \retval SA_OK    on success
+ *  \retval SA_ERROR on failure (events handler error)
+ */
+static sa_status_t sa_flush_events(syxa_t *sa) {
+    assert(NULL != sa);
+    assert(sa_events_enabled(sa));
+
+    int erno = sa->event_fn(sa->events, sa->event_cnt, sa->event_obj);
+
+    sa_clear_events(sa);
+
+    return erno ? SA_ERROR : SA_OK;
+}
+
+
+/**
+ *  \brief  Drop pending parsing events
+ *
+ *  \param  sa  Syntax analyser
+ */
+static void sa_clear_events(syxa_t *sa) {
+    assert(NULL != sa);
+
+    size_t i = 0;
+
+    for (; i < sa->event_cnt; ++i)
+        if (SA_EVENT_SHIFT == sa->events[i].type)
+            la_item_destroy(&sa->events[i].item);
+
+    sa->event_cnt = 0;
+}
+
+
 /**
  *  \brief  Cleanup (even incomplete) parse tree
  *
@@ -33,6 +33,7 @@
 
 #include "token.h"
 #include "lexical_analyser.h"
+#include "buffer.h"
 
 #include <assert.h>
 #include <stddef.h>
@@ -40,6 +41,13 @@
 #include <string.h>
 
 
+/** FNV-1a offset basis */
+#define TOKEN_HASH_BASIS ((size_t)(sizeof(size_t) > 4 ? 0xcbf29ce484222325ULL : 0x811c9dc5UL))
+
+/** FNV-1a prime */
+#define TOKEN_HASH_PRIME ((size_t)(sizeof(size_t) > 4 ? 0x100000001b3ULL : 0x01000193UL))
+
+
 /*
  * Static functions prototypes
  */
@@ -66,24 +74,136 @@ const char *token_data(token_t *token) {
 char *token_string(token_t *token) {
     assert(NULL != token);
 
-    size_t length;
-
-    const char *data = la_item_token((la_item_t *)token, &length);
-
-    if (NULL == data) return NULL;
+    size_t length = token_length(token);
 
     char *string = (char *)malloc((length + 1) * sizeof(char));
 
     if (NULL == string) return NULL;
 
-    memcpy(string, data, length);
+    /* Copy the fragments (the token isn't defragmented) */
+    token_iov_t iov;
+    const char *frag;
+    size_t      frag_len;
+    char       *str = string;
+
+    token_iov(token, &iov);
 
-    string[length] = '\0';
+    while (token_iov_next(&iov, &frag, &frag_len)) {
+        memcpy(str, frag, frag_len);
+
+        str += frag_len;
+    }
+
+    *str = '\0';
 
     return string;
 }
 
 
+void token_iov(token_t *token, token_iov_t *iov) {
+    assert(NULL != token);
+    assert(NULL != iov);
+
+    la_item_t *item = (la_item_t *)token;
+
+    iov->buffer = item->buff_1st;
+    iov->data   = item->token;
+    iov->offset = NULL != item->buff_1st ? item->buff_off : 0;
+    iov->to_go  = la_item_token_length(item);
+}
+
+
+int token_iov_next(token_iov_t *iov, const char **data, size_t *length) {
+    assert(NULL != iov);
+    assert(NULL != data);
+    assert(NULL != length);
+
+    if (0 == iov->to_go) return 0;
+
+    const buffer_t *buffer = (const buffer_t *)iov->buffer;
+
+    /* Inline token (single fragment) */
+    if (NULL == buffer) {
+        *data   = iov->data;
+        *length = iov->to_go;
+
+        iov->to_go = 0;
+
+        return 1;
+    }
+
+    size_t size = buffer_size(buffer) - iov->offset;
+
+    if (size > iov->to_go)
+        size = iov->to_go;
+
+    *data   = buffer_data(buffer) + iov->offset;
+    *length = size;
+
+    /* Move to the next buffer */
+    iov->to_go -= size;
+    iov->buffer = buffer_get_next(buffer);
+    iov->offset = 0;
+
+    return 1;
+}
+
+
+int token_compare(token_t *token, const char *data, size_t length) {
+    assert(NULL != token);
+    assert(NULL != data || 0 == length);
+
+    token_iov_t iov;
+    const char *frag;
+    size_t      frag_len;
+
+    token_iov(token, &iov);
+
+    while (token_iov_next(&iov, &frag, &frag_len)) {
+        /* Data is a proper prefix of the token */
+        if (frag_len > length) {
+            int cmp = memcmp(frag, data, length);
+
+            return cmp ? cmp : 1;
+        }
+
+        int cmp = memcmp(frag, data, frag_len);
+
+        if (cmp) return cmp;
+
+        data   += frag_len;
+        length -= frag_len;
+    }
+
+    /* Token is a prefix of the data */
+    return length ? -1 : 0;
+}
+
+
+size_t token_hash(token_t *token) {
+    assert(NULL != token);
+
+    size_t hash = TOKEN_HASH_BASIS;
+
+    token_iov_t iov;
+    const char *frag;
+    size_t      frag_len;
+
+    token_iov(token, &iov);
+
+    while (token_iov_next(&iov, &frag, &frag_len)) {
+        size_t i = 0;
+
+        for (; i < frag_len; ++i) {
+            hash ^= (unsigned char)frag[i];
+            hash *= TOKEN_HASH_PRIME;
+        }
+    }
+
+    return hash;
+}
+
+
 size_t token_length(token_t *token) {
     assert(NULL != token);
 
@@ -79,6 +79,251 @@ static const fsa_state_t  fsa_0x0000022d_state_0x00000218;
 static const fsa_branch_t fsa_0x0000022d_state_0x00000218_branch_0x0000022c;
 
 
+/*
+ * Direct-coded scanner
+ */
+
+/**
+ *  \brief  FSA 0x0000022d direct-coded scanner
+ *
+ *  See \ref fsa_scan_fn.
+ */
+static const fsa_state_t *fsa_0x0000022d_scan(
+    const fsa_state_t *state,
+    const char        *data,
+    size_t             size,
+    size_t            *offset)
+{
+    size_t off = *offset;
+
+    /* Resume scanning in the state */
+    switch (state->id) {
+        case 0x00000210: goto fsa_0x0000022d_state_0x00000210;
+        case 0x00000214: goto fsa_0x0000022d_state_0x00000214;
+        case 0x00000215: goto fsa_0x0000022d_state_0x00000215;
+        case 0x00000211: goto fsa_0x0000022d_state_0x00000211;
+        case 0x00000216: goto fsa_0x0000022d_state_0x00000216;
+        case 0x00000212: goto fsa_0x0000022d_state_0x00000212;
+        case 0x00000213: goto fsa_0x0000022d_state_0x00000213;
+        case 0x00000217: goto fsa_0x0000022d_state_0x00000217;
+        case 0x00000218: goto fsa_0x0000022d_state_0x00000218;
+        default: goto done;
+    }
+
+fsa_0x0000022d_state_0x00000210:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000210;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x2d:
+            goto fsa_0x0000022d_state_0x00000214;
+        case 0x28:
+            state = &fsa_0x0000022d_state_0x0000021b;
+            goto done;
+        case 0x30 ... 0x39:
+            state = &fsa_0x0000022d_state_0x00000215;
+            goto done;
+        case 0x29:
+            state = &fsa_0x0000022d_state_0x0000021a;
+            goto done;
+        case 0x2a:
+            state = &fsa_0x0000022d_state_0x00000219;
+            goto done;
+        case 0x2b:
+            state = &fsa_0x0000022d_state_0x00000218;
+            goto done;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000214:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000214;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x30 ... 0x39:
+            state = &fsa_0x0000022d_state_0x00000215;
+            goto done;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000215:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000215;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x30 ... 0x39:
+            goto fsa_0x0000022d_state_0x00000215_loop;
+        case 0x2e:
+            goto fsa_0x0000022d_state_0x00000211;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000215_loop:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000215;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off]) {
+        case 0x30 ... 0x39:
+            ++off;
+            goto fsa_0x0000022d_state_0x00000215_loop;
+        default:
+            state = &fsa_0x0000022d_state_0x00000215;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000211:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000211;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x30 ... 0x39:
+            state = &fsa_0x0000022d_state_0x00000216;
+            goto done;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000216:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000216;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x45:
+        case 0x65:
+            goto fsa_0x0000022d_state_0x00000212;
+        case 0x30 ... 0x39:
+            goto fsa_0x0000022d_state_0x00000216_loop;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000216_loop:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000216;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off]) {
+        case 0x30 ... 0x39:
+            ++off;
+            goto fsa_0x0000022d_state_0x00000216_loop;
+        default:
+            state = &fsa_0x0000022d_state_0x00000216;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000212:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000212;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x2b:
+        case 0x2d:
+            goto fsa_0x0000022d_state_0x00000213;
+        case 0x30 ... 0x39:
+            state = &fsa_0x0000022d_state_0x00000217;
+            goto done;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000213:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000213;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x30 ... 0x39:
+            state = &fsa_0x0000022d_state_0x00000217;
+            goto done;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000217:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000217;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x30 ... 0x39:
+            goto fsa_0x0000022d_state_0x00000217_loop;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000217_loop:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000217;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off]) {
+        case 0x30 ... 0x39:
+            ++off;
+            goto fsa_0x0000022d_state_0x00000217_loop;
+        default:
+            state = &fsa_0x0000022d_state_0x00000217;
+            goto done;
+    }
+
+fsa_0x0000022d_state_0x00000218:
+    if (off == size) {
+        state = &fsa_0x0000022d_state_0x00000218;
+        goto done;
+    }
+
+    switch ((unsigned char)data[off++]) {
+        case 0x30 ... 0x39:
+            state = &fsa_0x0000022d_state_0x00000215;
+            goto done;
+        default:
+            --off;
+            state = NULL;
+            goto done;
+    }
+
+done:
+    *offset = off;
+
+    return state;
+} /* end of FSA 0x0000022d direct-coded scanner */
+
 /**
  *  \brief  FSA 0x0000022d
  *
@@ -86,7 +331,11 @@ static const fsa_branch_t fsa_0x0000022d_state_0x00000218_branch_0x0000022c;
  */
 const fsa_t test_fsa = {
     .id          = 0x0000022d,
-    .root        = &fsa_0x0000022d_state_0x00000210
+    .root        = &fsa_0x0000022d_state_0x00000210,
+    .comb        = NULL,
+    .scan        = fsa_0x0000022d_scan,
+    .skip_cnt    = 0,
+    .skips       = NULL
 }; /* end of FSA 0x0000022d definition */
 
 
@@ -103,6 +352,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000210 = {
     .id          = 0x00000210,
     .accept_cnt  = 0,
     .accepts     = NULL,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 6,
     .branches    = {
         &fsa_0x0000022d_state_0x00000210_branch_0x0000021e,
@@ -195,6 +446,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000214 = {
     .id          = 0x00000214,
     .accept_cnt  = 0,
     .accepts     = NULL,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 1,
     .branches    = {
         &fsa_0x0000022d_state_0x00000214_branch_0x00000226,
@@ -216,6 +469,14 @@ static const fsa_branch_t fsa_0x0000022d_state_0x00000214_branch_0x00000226 = {
 /** \brief Lexical items accepted by FSA 0x0000022d state 0x00000215 */
 static const fsa_accept_t fsa_0x0000022d_state_0x00000215_accepts[] = { LEXI_number };
 
+/** \brief Self-loop of FSA 0x0000022d state 0x00000215 */
+static const fsa_loop_t fsa_0x0000022d_state_0x00000215_loop = {
+    .interval_cnt = 1,
+    .intervals    = {
+        { 0x30, 0x39 },
+    }
+};
+
 /**
  *  \brief  FSA 0x0000022d state 0x00000215
  *
@@ -225,6 +486,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000215 = {
     .id          = 0x00000215,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x00000215_accepts,
+    .trans       = NULL,
+    .self_loop   = &fsa_0x0000022d_state_0x00000215_loop,
     .branch_cnt  = 2,
     .branches    = {
         &fsa_0x0000022d_state_0x00000215_branch_0x00000227,
@@ -265,6 +528,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000211 = {
     .id          = 0x00000211,
     .accept_cnt  = 0,
     .accepts     = NULL,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 1,
     .branches    = {
         &fsa_0x0000022d_state_0x00000211_branch_0x00000222,
@@ -286,6 +551,14 @@ static const fsa_branch_t fsa_0x0000022d_state_0x00000211_branch_0x00000222 = {
 /** \brief Lexical items accepted by FSA 0x0000022d state 0x00000216 */
 static const fsa_accept_t fsa_0x0000022d_state_0x00000216_accepts[] = { LEXI_number };
 
+/** \brief Self-loop of FSA 0x0000022d state 0x00000216 */
+static const fsa_loop_t fsa_0x0000022d_state_0x00000216_loop = {
+    .interval_cnt = 1,
+    .intervals    = {
+        { 0x30, 0x39 },
+    }
+};
+
 /**
  *  \brief  FSA 0x0000022d state 0x00000216
  *
@@ -295,6 +568,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000216 = {
     .id          = 0x00000216,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x00000216_accepts,
+    .trans       = NULL,
+    .self_loop   = &fsa_0x0000022d_state_0x00000216_loop,
     .branch_cnt  = 2,
     .branches    = {
         &fsa_0x0000022d_state_0x00000216_branch_0x00000229,
@@ -336,6 +611,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000212 = {
     .id          = 0x00000212,
     .accept_cnt  = 0,
     .accepts     = NULL,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 2,
     .branches    = {
         &fsa_0x0000022d_state_0x00000212_branch_0x00000224,
@@ -377,6 +654,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000213 = {
     .id          = 0x00000213,
     .accept_cnt  = 0,
     .accepts     = NULL,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 1,
     .branches    = {
         &fsa_0x0000022d_state_0x00000213_branch_0x00000225,
@@ -398,6 +677,14 @@ static const fsa_branch_t fsa_0x0000022d_state_0x00000213_branch_0x00000225 = {
 /** \brief Lexical items accepted by FSA 0x0000022d state 0x00000217 */
 static const fsa_accept_t fsa_0x0000022d_state_0x00000217_accepts[] = { LEXI_number };
 
+/** \brief Self-loop of FSA 0x0000022d state 0x00000217 */
+static const fsa_loop_t fsa_0x0000022d_state_0x00000217_loop = {
+    .interval_cnt = 1,
+    .intervals    = {
+        { 0x30, 0x39 },
+    }
+};
+
 /**
  *  \brief  FSA 0x0000022d state 0x00000217
  *
@@ -407,6 +694,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000217 = {
     .id          = 0x00000217,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x00000217_accepts,
+    .trans       = NULL,
+    .self_loop   = &fsa_0x0000022d_state_0x00000217_loop,
     .branch_cnt  = 1,
     .branches    = {
         &fsa_0x0000022d_state_0x00000217_branch_0x0000022b,
@@ -437,6 +726,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x0000021b = {
     .id          = 0x0000021b,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x0000021b_accepts,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 0,
     .branches    = {
     }
@@ -454,6 +745,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x0000021a = {
     .id          = 0x0000021a,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x0000021a_accepts,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 0,
     .branches    = {
     }
@@ -471,6 +764,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000219 = {
     .id          = 0x00000219,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x00000219_accepts,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 0,
     .branches    = {
     }
@@ -488,6 +783,8 @@ static const fsa_state_t fsa_0x0000022d_state_0x00000218 = {
     .id          = 0x00000218,
     .accept_cnt  = 1,
     .accepts     = fsa_0x0000022d_state_0x00000218_accepts,
+    .trans       = NULL,
+    .self_loop   = NULL,
     .branch_cnt  = 1,
     .branches    = {
         &fsa_0x0000022d_state_0x00000218_branch_0x0000022c,
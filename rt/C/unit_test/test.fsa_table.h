@@ -34,9 +34,34 @@
 /**
  *  \brief  Lexical analyser FSA
  *
- *  The FSA tables are generated.
+ *  The FSA tables are generated (with direct-coded scanner).
  *  Don't change the code; change the definition, if required.
  */
 extern const fsa_t test_fsa;
 
+
+/**
+ *  \brief  Lexical analyser FSA (branches character intervals)
+ *
+ *  The same language as \ref test_fsa, generated with interval tables.
+ */
+extern const fsa_t test_fsa_interval;
+
+
+/**
+ *  \brief  Lexical analyser FSA (dense transition tables)
+ *
+ *  The same language as \ref test_fsa, generated with dense transition rows.
+ */
+extern const fsa_t test_fsa_dense;
+
+
+/**
+ *  \brief  Lexical analyser FSA (comb-vector transitions)
+ *
+ *  The same language as \ref test_fsa, generated with comb-vector
+ *  transitions (see \c ctx-fryer-re2fsa \c --comb).
+ */
+extern const fsa_t test_fsa_comb;
+
 #endif  /* end of #ifndef CTXFryer__test_fsa_table_h */
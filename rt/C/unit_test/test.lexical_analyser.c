@@ -32,6 +32,8 @@
 #include "buffer.h"
 #include "fsa.h"
 #include "lexical_analyser.h"
+#include "la_parallel.h"
+#include "token.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -118,6 +120,60 @@ static int   compact     = 0;                      /**< Non-null means compact p
 static char *line        = NULL;                   /**< Line from input               */
 static int   seg_max     = DEFAULT_MAX_SEG_CNT;    /**< Max. amount of segments       */
 static int   seg_add_max = DEFAULT_MAX_SEG_ADD;    /**< Max. amount of added segments */
+static const char  *fsa_tables = "interval";      /**< FSA tables form               */
+static const fsa_t *fsa  = NULL;                   /**< Lexical analyser FSA          */
+static la_pos_mode_t pos_mode = LA_POS_LINE_COLUMN; /**< Position tracking mode        */
+static fsa_accept_t skip_item = LEXIG_EOF;         /**< Skipped lexical item (if any) */
+static int          batch_cap = 0;                 /**< Batch capacity (0: no batch)  */
+static int          threads   = 0;                 /**< Thread count (0: sequential)  */
+static int          overrun_len = 0;               /**< Overrun linearity check input */
+
+
+/*
+ * Overrun FSA (items "a" and "a+b"); input "aaa...a" is pathological
+ * for the analyser: all the input is overrun by the "a+b" item scan
+ */
+
+#define OVERRUN_ITEM_A   1  /**< Overrun FSA item "a"   */
+#define OVERRUN_ITEM_AB  2  /**< Overrun FSA item "a+b" */
+
+/** Overrun FSA check steps limit (per input character) */
+#define OVERRUN_STEPS_MAX 8
+
+static const fsa_state_t  overrun_state_root;
+static const fsa_state_t  overrun_state_a;
+static const fsa_state_t  overrun_state_aa;
+static const fsa_state_t  overrun_state_ab;
+
+static const fsa_accept_t overrun_accept_a[]  = { OVERRUN_ITEM_A };
+static const fsa_accept_t overrun_accept_ab[] = { OVERRUN_ITEM_AB };
+
+static const fsa_branch_t overrun_branch_root_a = {
+    .id = 1, .target = &overrun_state_a,  .interval_cnt = 1, .intervals = { { 'a', 'a' } } };
+static const fsa_branch_t overrun_branch_a_a = {
+    .id = 2, .target = &overrun_state_aa, .interval_cnt = 1, .intervals = { { 'a', 'a' } } };
+static const fsa_branch_t overrun_branch_a_b = {
+    .id = 3, .target = &overrun_state_ab, .interval_cnt = 1, .intervals = { { 'b', 'b' } } };
+static const fsa_branch_t overrun_branch_aa_a = {
+    .id = 4, .target = &overrun_state_aa, .interval_cnt = 1, .intervals = { { 'a', 'a' } } };
+static const fsa_branch_t overrun_branch_aa_b = {
+    .id = 5, .target = &overrun_state_ab, .interval_cnt = 1, .intervals = { { 'b', 'b' } } };
+
+static const fsa_loop_t overrun_loop_aa = { .interval_cnt = 1, .intervals = { { 'a', 'a' } } };
+
+static const fsa_state_t overrun_state_root = {
+    .id = 1, .branch_cnt = 1, .branches = { &overrun_branch_root_a } };
+static const fsa_state_t overrun_state_a = {
+    .id = 2, .accept_cnt = 1, .accepts = overrun_accept_a,
+    .branch_cnt = 2, .branches = { &overrun_branch_a_a, &overrun_branch_a_b } };
+static const fsa_state_t overrun_state_aa = {
+    .id = 3, .self_loop = &overrun_loop_aa,
+    .branch_cnt = 2, .branches = { &overrun_branch_aa_a, &overrun_branch_aa_b } };
+static const fsa_state_t overrun_state_ab = {
+    .id = 4, .accept_cnt = 1, .accepts = overrun_accept_ab };
+
+/** Overrun FSA */
+static const fsa_t overrun_fsa = { .id = 1, .root = &overrun_state_root };
 
 
 /*
@@ -140,8 +196,12 @@ static void buffer_over_segment_cleanup(void *segment, char *data, size_t size);
 static void process_lexical_items(const la_item_t *items, size_t item_cnt);
 
 static int segment_test(lexa_t *lexa, segment_seq_t *seg_seq);
+static int segment_test_parallel(const char *line, size_t line_len);
 static int segment_line(char *line, size_t line_len);
 
+static int overrun_steps(size_t length, size_t *steps);
+static int overrun_test(size_t length);
+
 static void usage(const char *this);
 
 static void finalise(void) __attribute__((destructor));
@@ -450,6 +510,11 @@ static void process_lexical_items(const la_item_t *items, size_t item_cnt) {
 
         la_item_copy(&item, const_item);
 
+        /* Token views work on (generally fragmented) token directly */
+        int    token_cmp = token_compare(&item, line + la_item_token_offset(&item),
+                                         la_item_token_length(&item));
+        size_t token_hsh = token_hash(&item);
+
         size_t      token_len;
         const char *token      = la_item_token(&item, &token_len);
         size_t      token_off  = la_item_token_offset(&item);
@@ -459,6 +524,28 @@ static void process_lexical_items(const la_item_t *items, size_t item_cnt) {
         INFO("%2zu: code: %d, pos: %zu:%zu (offset %zu), \"%.*s\" (%zu bytes)",
              i + 1, code, token_line, token_col, token_off, (int)token_len, token, token_len);
 
+        if (token_cmp || token_hsh != token_hash(&item)) {
+            FATAL("Token view doesn't match token data (offset %zu)", token_off);
+
+            exit(1);
+        }
+
+        /* Copy of defragmented item (short token is inline) */
+        la_item_t item_copy;
+
+        la_item_copy(&item_copy, &item);
+
+        size_t      copy_len;
+        const char *copy_token = la_item_token(&item_copy, &copy_len);
+
+        if (copy_len != token_len || memcmp(copy_token, token, token_len)) {
+            FATAL("Lexical item copy token doesn't match (offset %zu)", token_off);
+
+            exit(1);
+        }
+
+        la_item_destroy(&item_copy);
+
         if (!quiet) {
             if (compact) {
                 fprintf(stdout, ";%d@%zu:%zu(%zu,%zu)\"%.*s\"",
@@ -623,6 +710,259 @@ static int segment_test(lexa_t *lexa, segment_seq_t *seg_seq) {
 }
 
 
+/**
+ *  \brief  Print lexical items batch
+ *
+ *  The batch tokens are printed to std. output (as single items).
+ *
+ *  \param  batch  Lexical items batch
+ *  \param  data   Source data
+ */
+static void process_lexical_batch(const la_batch_t *batch, const char *data) {
+    assert(NULL != batch);
+
+    INFO("%zu token(s) provided in batch by lexical analyser", batch->cnt);
+
+    size_t i = 0;
+
+    for (; i < batch->cnt; ++i) {
+        int         code       = batch->codes[i];
+        size_t      token_off  = batch->offsets[i];
+        size_t      token_len  = batch->lengths[i];
+        size_t      token_line = batch->lines[i];
+        size_t      token_col  = batch->columns[i];
+        const char *token      = data + token_off;
+
+        /* End of file is printed separately */
+        if (LEXIG_EOF == code) break;
+
+        INFO("%2zu: code: %d, pos: %zu:%zu (offset %zu), \"%.*s\" (%zu bytes)",
+             i + 1, code, token_line, token_col, token_off, (int)token_len, token, token_len);
+
+        if (!quiet) {
+            if (compact) {
+                fprintf(stdout, "1;%d@%zu:%zu(%zu,%zu)\"%.*s\"\n",
+                                code, token_line, token_col, token_off, token_len, (int)token_len, token);
+            }
+            else {
+                fprintf(stdout, "--- 1 lexical item printout ---\n");
+                fprintf(stdout, " 1) Item code: %d\n", code);
+                fprintf(stdout, "    Token: \"%.*s\" (length %zu)\n", (int)token_len, token, token_len);
+                fprintf(stdout, "    Position: line %zu, column %zu, offset %zu\n", token_line, token_col, token_off);
+                fprintf(stdout, "--- End of lexical item printout ---\n");
+            }
+        }
+    }
+}
+
+
+/**
+ *  \brief  Perform batch tokenization test
+ *
+ *  Same as \ref segment_test, but the source is tokenized
+ *  in batches by \ref la_tokenize_batch.
+ *
+ *  \param  lexa     Lexical analyser
+ *  \param  seg_seq  Segment sequence (the source)
+ *  \param  batch    Lexical items batch
+ *  \param  data     Source data
+ *
+ *  \retval 0      on success
+ *  \retval EINVAL if the the lexical analyser failed
+ */
+static int segment_test_batch(lexa_t *lexa, segment_seq_t *seg_seq, la_batch_t *batch, const char *data) {
+    size_t seg_added = 0;
+
+    while (seg_added < segment_seq_cnt(seg_seq)) {
+        /* Add random amount of segments */
+        size_t to_add     = (size_t)rand_from(0, seg_add_max);
+        size_t to_add_max = segment_seq_cnt(seg_seq) - seg_added;
+
+        if (to_add > to_add_max)
+            to_add = to_add_max;
+
+        la_status_t la_status;
+
+        while (to_add--) {
+            segment_t *seg = segment_seq_at(seg_seq, seg_added);
+
+            char   *seg_data = segment_use_data(seg);
+            size_t  size     = segment_size(seg);
+            int     last     = seg_added + 1 == segment_seq_cnt(seg_seq);
+
+            la_status = la_add_data(lexa, seg_data, size,
+                                    buffer_over_segment_cleanup, seg,
+                                    last);
+            if (LA_OK != la_status) {
+                ERROR("Failed to feed lexical analyser with data: %d", la_status);
+
+                segment_drop_data(seg);
+                return EINVAL;
+            }
+
+            ++seg_added;
+        }
+
+        do {
+            la_status = la_tokenize_batch(lexa, batch);
+
+            process_lexical_batch(batch, data);
+
+            switch (la_status) {
+                case LA_OK:
+                    /* Batch is either full or EoF was reached */
+                    if (!batch->cnt) {
+                        ERROR("At least 1 token expected");
+
+                        return EINVAL;
+                    }
+
+                    if (LEXIG_EOF == batch->codes[batch->cnt - 1]) {
+                        DEBUG("Got end-of-file token, tokenization done");
+
+                        if (!quiet) {
+                            if (compact) {
+                                fprintf(stdout, "Line OK\n");
+                            }
+                            else {
+                                fprintf(stdout, "--- Line OK ---\n");
+                            }
+                        }
+
+                        return 0;
+                    }
+
+                    break;
+
+                case LA_INPUT_EXHAUSTED:
+                    DEBUG("Input exhausted");
+
+                    break;
+
+                case LA_INPUT_INVALID:
+                    WARN("Input can't be tokenized further (no match)");
+
+                    if (!quiet) {
+                        if (compact) {
+                            fprintf(stdout, "Line invalid\n");
+                        }
+                        else {
+                            fprintf(stdout, "--- Line invalid ---\n");
+                        }
+                    }
+
+                    return 0;
+
+                case LA_ERROR:
+                    ERROR("Failed to tokenize source");
+
+                    return EINVAL;
+            }
+
+            /* Tokens consumed */
+            batch->cnt = 0;
+
+        } while (LA_OK == la_status);
+    }
+
+    ERROR("All segments were already fed to lexical analyser, yet EoF wasn't reached");
+
+    return EINVAL;
+}
+
+
+/**
+ *  \brief  Perform parallel tokenization test
+ *
+ *  The line is tokenized by \ref la_tokenize_parallel
+ *  (no segmentation takes place, the source must be contiguous).
+ *  Tokens are printed the same way as batch tokens.
+ *
+ *  \param  line      Input line
+ *  \param  line_len  Length of the input line
+ *
+ *  \retval 0      on success
+ *  \retval ENOMEM on memory allocation failure
+ *  \retval EINVAL if the the lexical analyser failed
+ */
+static int segment_test_parallel(const char *line, size_t line_len) {
+    la_tokens_t tokens;
+
+    la_tokens_create(&tokens);
+
+    la_status_t la_status = la_tokenize_parallel(fsa, LEXICNT, line, line_len,
+                                                 (size_t)threads, &tokens);
+
+    if (LA_ERROR == la_status) {
+        ERROR("Failed to tokenize source");
+
+        la_tokens_destroy(&tokens);
+
+        return EINVAL;
+    }
+
+    /* Resolve token positions */
+    size_t *lines   = (size_t *)malloc((tokens.cnt + 1) * sizeof(size_t));
+    size_t *columns = (size_t *)malloc((tokens.cnt + 1) * sizeof(size_t));
+
+    if (NULL == lines || NULL == columns) {
+        ERROR("Failed to allocate token position arrays");
+
+        free(lines);
+        free(columns);
+
+        la_tokens_destroy(&tokens);
+
+        return ENOMEM;
+    }
+
+    size_t line_no = 1;
+    size_t line_of = 0;
+    size_t off     = 0;
+    size_t i       = 0;
+
+    for (; i < tokens.cnt; ++i) {
+        for (; off < tokens.offsets[i]; ++off) {
+            if ('\n' == line[off]) {
+                ++line_no;
+                line_of = off + 1;
+            }
+        }
+
+        lines[i]   = line_no;
+        columns[i] = tokens.offsets[i] - line_of + 1;
+    }
+
+    la_batch_t batch = {
+        .capacity = tokens.cnt,
+        .cnt      = tokens.cnt,
+        .codes    = tokens.codes,
+        .offsets  = tokens.offsets,
+        .lengths  = tokens.lengths,
+        .lines    = lines,
+        .columns  = columns,
+    };
+
+    process_lexical_batch(&batch, line);
+
+    if (!quiet) {
+        if (compact) {
+            fprintf(stdout, LA_OK == la_status ? "Line OK\n" : "Line invalid\n");
+        }
+        else {
+            fprintf(stdout, LA_OK == la_status ? "--- Line OK ---\n" : "--- Line invalid ---\n");
+        }
+    }
+
+    free(lines);
+    free(columns);
+
+    la_tokens_destroy(&tokens);
+
+    return 0;
+}
+
+
 /**
  *  \brief  Segment input line
  *
@@ -660,10 +1000,46 @@ static int segment_line(char *line, size_t line_len) {
     /* Create lexical analyser */
     lexa_t lexa;
 
-    la_create(&lexa, &test_fsa, LEXICNT);
+    la_create(&lexa, fsa, LEXICNT);
+
+    la_set_pos_mode(&lexa, pos_mode);
 
     /* Test lexical analyser */
-    status = segment_test(&lexa, &seg_seq);
+    if (threads) {
+        status = segment_test_parallel(line, line_len);
+    }
+    else if (batch_cap) {
+        la_batch_t batch = {
+            .capacity = (size_t)batch_cap,
+            .cnt      = 0,
+            .codes    = (int *)malloc(batch_cap * sizeof(int)),
+            .offsets  = (size_t *)malloc(batch_cap * sizeof(size_t)),
+            .lengths  = (size_t *)malloc(batch_cap * sizeof(size_t)),
+            .lines    = (size_t *)malloc(batch_cap * sizeof(size_t)),
+            .columns  = (size_t *)malloc(batch_cap * sizeof(size_t)),
+        };
+
+        if (NULL == batch.codes   || NULL == batch.offsets ||
+            NULL == batch.lengths || NULL == batch.lines   ||
+            NULL == batch.columns)
+        {
+            ERROR("Failed to allocate batch arrays");
+
+            status = ENOMEM;
+        }
+        else {
+            status = segment_test_batch(&lexa, &seg_seq, &batch, line);
+        }
+
+        free(batch.codes);
+        free(batch.offsets);
+        free(batch.lengths);
+        free(batch.lines);
+        free(batch.columns);
+    }
+    else {
+        status = segment_test(&lexa, &seg_seq);
+    }
 
     /* Destroy lexical analyser */
     la_destroy(&lexa);
@@ -675,6 +1051,132 @@ static int segment_line(char *line, size_t line_len) {
 }
 
 
+/**
+ *  \brief  Count FSA transitions taken when analysing overrun input
+ *
+ *  The input is \c length times \c a (see \ref overrun_fsa);
+ *  the longest items are always read.
+ *
+ *  \param  length  Input length
+ *  \param  steps   FSA transitions count (output)
+ *
+ *  \retval 0 on success
+ *  \retval non-zero on failure
+ */
+static int overrun_steps(size_t length, size_t *steps) {
+    char *data = (char *)malloc(length);
+
+    if (NULL == data) {
+        FATAL("Failed to allocate overrun input");
+
+        return 1;
+    }
+
+    memset(data, 'a', length);
+
+    lexa_t lexa;
+
+    if (NULL == la_create(&lexa, &overrun_fsa, LEXICNT)) {
+        FATAL("Failed to create lexical analyser");
+
+        free(data);
+
+        return 1;
+    }
+
+    int error = LA_OK != la_add_data(&lexa, data, length, NULL, NULL, 1);
+
+    size_t item_cnt = 0;
+
+    while (!error) {
+        const la_item_t *items;
+        size_t           cnt;
+
+        if (LA_OK != la_get_items(&lexa, &items, &cnt)) {
+            ERROR("Lexical analysis failed (status %d)", la_status(&lexa));
+
+            error = 1;
+
+            break;
+        }
+
+        /* Choose the longest item */
+        const la_item_t *item = items;
+
+        size_t i = 1;
+
+        for (; i < cnt; ++i)
+            if (items[i].length > item->length) item = items + i;
+
+        if (LEXIG_EOF == item->code) break;
+
+        if (OVERRUN_ITEM_A != item->code || 1 != item->length) {
+            ERROR("Unexpected item %d of length %zu", item->code, item->length);
+
+            error = 1;
+
+            break;
+        }
+
+        la_read_item(&lexa, item->code);
+
+        ++item_cnt;
+    }
+
+    *steps = la_steps(&lexa);
+
+    la_destroy(&lexa);
+
+    free(data);
+
+    if (!error && item_cnt != length) {
+        ERROR("%zu items read instead of %zu", item_cnt, length);
+
+        error = 1;
+    }
+
+    INFO("Overrun input of length %zu: %zu FSA transitions", length, *steps);
+
+    return error;
+}
+
+
+/**
+ *  \brief  Check that overrun input analysis is linear
+ *
+ *  FSA transitions count must be bounded by the input length
+ *  (multiplied by \ref OVERRUN_STEPS_MAX) and it must grow (at most)
+ *  linearly with it.
+ *
+ *  \param  length  Input length
+ *
+ *  \retval 0 on success
+ *  \retval non-zero on failure
+ */
+static int overrun_test(size_t length) {
+    size_t steps1, steps2;
+
+    if (overrun_steps(length,     &steps1)) return 1;
+    if (overrun_steps(2 * length, &steps2)) return 1;
+
+    if (steps1 > OVERRUN_STEPS_MAX * length) {
+        ERROR("Too many FSA transitions: %zu for input of length %zu", steps1, length);
+
+        return 1;
+    }
+
+    /* Quadratic growth would make that 4 times */
+    if (steps2 > 2 * steps1 + OVERRUN_STEPS_MAX) {
+        ERROR("FSA transitions grow super-linearly: %zu for length %zu, %zu for length %zu",
+              steps1, length, steps2, 2 * length);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+
 /**
  *  \brief  Usage
  *
@@ -693,6 +1195,12 @@ static void usage(const char *this) {
     LOG("    -s <seg. count>     set maximal segment count, default: %d", DEFAULT_MAX_SEG_CNT);
     LOG("    -a <seg. count>     set maximal count of segmemnts added at a time, default: %d", DEFAULT_MAX_SEG_ADD);
     LOG("    -S <RNG seed>       set random number generator seed");
+    LOG("    -f <FSA tables>     set FSA tables form (interval, dense, comb or direct), default: interval");
+    LOG("    -o                  track offsets only (lines and columns are computed on demand)");
+    LOG("    -i <item code>      skip (ignore) lexical item");
+    LOG("    -b <capacity>       tokenize in batches of the capacity");
+    LOG("    -p <threads>        tokenize in parallel (by chunks)");
+    LOG("    -r <length>         check that overrun input of the length is analysed in linear time");
     LOG("");
     LOG("Log level is an inverted threshold for message levels.");
     LOG("The lower it is, the less output is produced.");
@@ -724,7 +1232,7 @@ int main(int argc, char * const argv[]) {
 
     int opt;
 
-    while (-1 != (opt = getopt(argc, argv, "hqcl:s:a:S:"))) {
+    while (-1 != (opt = getopt(argc, argv, "hqcl:s:a:S:f:oi:b:p:r:"))) {
         switch (opt) {
             case 'h':
                 usage(argv[0]);
@@ -762,6 +1270,36 @@ int main(int argc, char * const argv[]) {
 
                 break;
 
+            case 'f':
+                fsa_tables = optarg;
+
+                break;
+
+            case 'o':
+                pos_mode = LA_POS_OFFSET;
+
+                break;
+
+            case 'i':
+                skip_item = (fsa_accept_t)atoi(optarg);
+
+                break;
+
+            case 'b':
+                batch_cap = atoi(optarg);
+
+                break;
+
+            case 'p':
+                threads = atoi(optarg);
+
+                break;
+
+            case 'r':
+                overrun_len = atoi(optarg);
+
+                break;
+
             default:
                 FATAL("Failed to process options");
 
@@ -791,6 +1329,59 @@ int main(int argc, char * const argv[]) {
         exit(1);
     }
 
+    if (batch_cap < 0) {
+        FATAL("Batch capacity is invalid: %d", batch_cap);
+
+        usage(argv[0]);
+        exit(1);
+    }
+
+    if (threads < 0) {
+        FATAL("Thread count is invalid: %d", threads);
+
+        usage(argv[0]);
+        exit(1);
+    }
+
+    if (overrun_len < 0) {
+        FATAL("Overrun input length is invalid: %d", overrun_len);
+
+        usage(argv[0]);
+        exit(1);
+    }
+
+    if (!(skip_item < LEXICNT)) {
+        FATAL("Skipped lexical item code is invalid: %u", skip_item);
+
+        usage(argv[0]);
+        exit(1);
+    }
+
+    /* Overrun linearity check (doesn't read input) */
+    if (overrun_len)
+        return overrun_test((size_t)overrun_len);
+
+    if (0 == strcmp(fsa_tables, "interval"))
+        fsa = &test_fsa_interval;
+    else if (0 == strcmp(fsa_tables, "dense"))
+        fsa = &test_fsa_dense;
+    else if (0 == strcmp(fsa_tables, "comb"))
+        fsa = &test_fsa_comb;
+    else if (0 == strcmp(fsa_tables, "direct"))
+        fsa = &test_fsa;
+    else {
+        FATAL("Unknown FSA tables form: %s", fsa_tables);
+
+        usage(argv[0]);
+        exit(1);
+    }
+
+    /* Use FSA with the skipped item */
+    const fsa_t skip_fsa = fsa_with_skips(fsa, 1, &skip_item);
+
+    if (LEXIG_EOF != skip_item)
+        fsa = &skip_fsa;
+
     /* Seed RNG */
     /* Always log this so that a failed test may be re-run */
     srand(rng_seed);
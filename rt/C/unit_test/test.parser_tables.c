@@ -34,177 +34,258 @@
 #include <assert.h>
 
 
-/*
- * Actions
- */
-
-static const sa_action_t s3  = { .type = SA_ACTION_SHIFT, .t.shift.next_state = 3 };
-static const sa_action_t s4  = { .type = SA_ACTION_SHIFT, .t.shift.next_state = 4 };
-static const sa_action_t s6  = { .type = SA_ACTION_SHIFT, .t.shift.next_state = 6 };
-static const sa_action_t s7  = { .type = SA_ACTION_SHIFT, .t.shift.next_state = 7 };
-static const sa_action_t s11 = { .type = SA_ACTION_SHIFT, .t.shift.next_state = 11 };
-
-static const sa_action_t r1 = { .type = SA_ACTION_REDUCE, .t.reduce.rule_no = 1 };
-static const sa_action_t r2 = { .type = SA_ACTION_REDUCE, .t.reduce.rule_no = 2 };
-static const sa_action_t r3 = { .type = SA_ACTION_REDUCE, .t.reduce.rule_no = 3 };
-static const sa_action_t r4 = { .type = SA_ACTION_REDUCE, .t.reduce.rule_no = 4 };
-static const sa_action_t r5 = { .type = SA_ACTION_REDUCE, .t.reduce.rule_no = 5 };
-static const sa_action_t r6 = { .type = SA_ACTION_REDUCE, .t.reduce.rule_no = 6 };
-
-static const sa_action_t acc = { .type = SA_ACTION_ACCEPT };
-
-
 /** Action table implementation */
-static const sa_action_t *action_tab_impl[12 * 6] = {
-    /*  0:EOF    */  NULL,
-    /*  0:number */  &s3,
-    /*  0:add    */  NULL,
-    /*  0:mul    */  NULL,
-    /*  0:rpar   */  NULL,
-    /*  0:lpar   */  &s4,
-
-    /*  1:EOF    */  &acc,
-    /*  1:number */  NULL,
-    /*  1:add    */  &s6,
-    /*  1:mul    */  NULL,
-    /*  1:rpar   */  NULL,
-    /*  1:lpar   */  NULL,
-
-    /*  2:EOF    */  &r2,
-    /*  2:number */  NULL,
-    /*  2:add    */  &r2,
-    /*  2:mul    */  &s7,
-    /*  2:rpar   */  &r2,
-    /*  2:lpar   */  NULL,
-
-    /*  3:EOF    */  &r6,
-    /*  3:number */  NULL,
-    /*  3:add    */  &r6,
-    /*  3:mul    */  &r6,
-    /*  3:rpar   */  &r6,
-    /*  3:lpar   */  NULL,
-
-    /*  4:EOF    */  NULL,
-    /*  4:number */  &s3,
-    /*  4:add    */  NULL,
-    /*  4:mul    */  NULL,
-    /*  4:rpar   */  NULL,
-    /*  4:lpar   */  &s4,
-
-    /*  5:EOF    */  &r4,
-    /*  5:number */  NULL,
-    /*  5:add    */  &r4,
-    /*  5:mul    */  &r4,
-    /*  5:rpar   */  &r4,
-    /*  5:lpar   */  NULL,
-
-    /*  6:EOF    */  NULL,
-    /*  6:number */  &s3,
-    /*  6:add    */  NULL,
-    /*  6:mul    */  NULL,
-    /*  6:rpar   */  NULL,
-    /*  6:lpar   */  &s4,
-
-    /*  7:EOF    */  NULL,
-    /*  7:number */  &s3,
-    /*  7:add    */  NULL,
-    /*  7:mul    */  NULL,
-    /*  7:rpar   */  NULL,
-    /*  7:lpar   */  &s4,
-
-    /*  8:EOF    */  NULL,
-    /*  8:number */  NULL,
-    /*  8:add    */  &s6,
-    /*  8:mul    */  NULL,
-    /*  8:rpar   */  &s11,
-    /*  8:lpar   */  NULL,
-
-    /*  9:EOF    */  &r1,
-    /*  9:number */  NULL,
-    /*  9:add    */  &r1,
-    /*  9:mul    */  &s7,
-    /*  9:rpar   */  &r1,
-    /*  9:lpar   */  NULL,
-
-    /* 10:EOF    */  &r3,
-    /* 10:number */  NULL,
-    /* 10:add    */  &r3,
-    /* 10:mul    */  &r3,
-    /* 10:rpar   */  &r3,
-    /* 10:lpar   */  NULL,
-
-    /* 11:EOF    */  &r5,
-    /* 11:number */  NULL,
-    /* 11:add    */  &r5,
-    /* 11:mul    */  &r5,
-    /* 11:rpar   */  &r5,
-    /* 11:lpar   */  NULL,
+static const uint16_t action_tab_impl[12 * 6] = {
+    /*  0:EOF    */  SA_ACTION_REJECT_INIT,
+    /*  0:number */  SA_ACTION_SHIFT_INIT(3),
+    /*  0:add    */  SA_ACTION_REJECT_INIT,
+    /*  0:mul    */  SA_ACTION_REJECT_INIT,
+    /*  0:rpar   */  SA_ACTION_REJECT_INIT,
+    /*  0:lpar   */  SA_ACTION_SHIFT_INIT(4),
+
+    /*  1:EOF    */  SA_ACTION_ACCEPT_INIT,
+    /*  1:number */  SA_ACTION_REJECT_INIT,
+    /*  1:add    */  SA_ACTION_SHIFT_INIT(6),
+    /*  1:mul    */  SA_ACTION_REJECT_INIT,
+    /*  1:rpar   */  SA_ACTION_REJECT_INIT,
+    /*  1:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /*  2:EOF    */  SA_ACTION_REDUCE_INIT(2),
+    /*  2:number */  SA_ACTION_REJECT_INIT,
+    /*  2:add    */  SA_ACTION_REDUCE_INIT(2),
+    /*  2:mul    */  SA_ACTION_SHIFT_INIT(7),
+    /*  2:rpar   */  SA_ACTION_REDUCE_INIT(2),
+    /*  2:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /*  3:EOF    */  SA_ACTION_REDUCE_INIT(6),
+    /*  3:number */  SA_ACTION_REJECT_INIT,
+    /*  3:add    */  SA_ACTION_REDUCE_INIT(6),
+    /*  3:mul    */  SA_ACTION_REDUCE_INIT(6),
+    /*  3:rpar   */  SA_ACTION_REDUCE_INIT(6),
+    /*  3:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /*  4:EOF    */  SA_ACTION_REJECT_INIT,
+    /*  4:number */  SA_ACTION_SHIFT_INIT(3),
+    /*  4:add    */  SA_ACTION_REJECT_INIT,
+    /*  4:mul    */  SA_ACTION_REJECT_INIT,
+    /*  4:rpar   */  SA_ACTION_REJECT_INIT,
+    /*  4:lpar   */  SA_ACTION_SHIFT_INIT(4),
+
+    /*  5:EOF    */  SA_ACTION_REDUCE_INIT(4),
+    /*  5:number */  SA_ACTION_REJECT_INIT,
+    /*  5:add    */  SA_ACTION_REDUCE_INIT(4),
+    /*  5:mul    */  SA_ACTION_REDUCE_INIT(4),
+    /*  5:rpar   */  SA_ACTION_REDUCE_INIT(4),
+    /*  5:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /*  6:EOF    */  SA_ACTION_REJECT_INIT,
+    /*  6:number */  SA_ACTION_SHIFT_INIT(3),
+    /*  6:add    */  SA_ACTION_REJECT_INIT,
+    /*  6:mul    */  SA_ACTION_REJECT_INIT,
+    /*  6:rpar   */  SA_ACTION_REJECT_INIT,
+    /*  6:lpar   */  SA_ACTION_SHIFT_INIT(4),
+
+    /*  7:EOF    */  SA_ACTION_REJECT_INIT,
+    /*  7:number */  SA_ACTION_SHIFT_INIT(3),
+    /*  7:add    */  SA_ACTION_REJECT_INIT,
+    /*  7:mul    */  SA_ACTION_REJECT_INIT,
+    /*  7:rpar   */  SA_ACTION_REJECT_INIT,
+    /*  7:lpar   */  SA_ACTION_SHIFT_INIT(4),
+
+    /*  8:EOF    */  SA_ACTION_REJECT_INIT,
+    /*  8:number */  SA_ACTION_REJECT_INIT,
+    /*  8:add    */  SA_ACTION_SHIFT_INIT(6),
+    /*  8:mul    */  SA_ACTION_REJECT_INIT,
+    /*  8:rpar   */  SA_ACTION_SHIFT_INIT(11),
+    /*  8:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /*  9:EOF    */  SA_ACTION_REDUCE_INIT(1),
+    /*  9:number */  SA_ACTION_REJECT_INIT,
+    /*  9:add    */  SA_ACTION_REDUCE_INIT(1),
+    /*  9:mul    */  SA_ACTION_SHIFT_INIT(7),
+    /*  9:rpar   */  SA_ACTION_REDUCE_INIT(1),
+    /*  9:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /* 10:EOF    */  SA_ACTION_REDUCE_INIT(3),
+    /* 10:number */  SA_ACTION_REJECT_INIT,
+    /* 10:add    */  SA_ACTION_REDUCE_INIT(3),
+    /* 10:mul    */  SA_ACTION_REDUCE_INIT(3),
+    /* 10:rpar   */  SA_ACTION_REDUCE_INIT(3),
+    /* 10:lpar   */  SA_ACTION_REJECT_INIT,
+
+    /* 11:EOF    */  SA_ACTION_REDUCE_INIT(5),
+    /* 11:number */  SA_ACTION_REJECT_INIT,
+    /* 11:add    */  SA_ACTION_REDUCE_INIT(5),
+    /* 11:mul    */  SA_ACTION_REDUCE_INIT(5),
+    /* 11:rpar   */  SA_ACTION_REDUCE_INIT(5),
+    /* 11:lpar   */  SA_ACTION_REJECT_INIT,
+};
+
+/** Default actions (reductions done regardless of the look-ahead) */
+static const uint16_t default_tab_impl[12] = {
+    /*  0 */  SA_ACTION_REJECT_INIT,
+    /*  1 */  SA_ACTION_REJECT_INIT,
+    /*  2 */  SA_ACTION_REJECT_INIT,
+    /*  3 */  SA_ACTION_REDUCE_INIT(6),
+    /*  4 */  SA_ACTION_REJECT_INIT,
+    /*  5 */  SA_ACTION_REDUCE_INIT(4),
+    /*  6 */  SA_ACTION_REJECT_INIT,
+    /*  7 */  SA_ACTION_REJECT_INIT,
+    /*  8 */  SA_ACTION_REJECT_INIT,
+    /*  9 */  SA_ACTION_REJECT_INIT,
+    /* 10 */  SA_ACTION_REDUCE_INIT(3),
+    /* 11 */  SA_ACTION_REDUCE_INIT(5),
 };
 
 /* Action table */
 const lr1_action_tab_t test_action_tab = {
     .state_cnt    = 12,
     .lex_item_cnt = 6,
-    .impl         = &action_tab_impl,
+    .width        = sizeof(action_tab_impl[0]),
+    .impl.w16     = action_tab_impl,
+    .dflt.w16     = default_tab_impl,
+};
+
+/** Direct-coded parser */
+static sa_direct_parse_fn lr1_parse;
+
+/* Action table (direct-coded parser) */
+const lr1_action_tab_t test_direct_action_tab = {
+    .state_cnt    = 12,
+    .lex_item_cnt = 6,
+    .width        = sizeof(action_tab_impl[0]),
+    .parse        = lr1_parse,
 };
 
 
 /** Goto table implementation */
-static const size_t goto_tab_impl[12 * 3] = {
+static const uint16_t goto_tab_impl[12 * 3] = {
     /*  0:F */  2,
     /*  0:T */  5,
     /*  0:E */  1,
 
-    /*  1:F */  SA_NULL_TARGET,
-    /*  1:T */  SA_NULL_TARGET,
-    /*  1:E */  SA_NULL_TARGET,
+    /*  1:F */  SA_NULL_TARGET16,
+    /*  1:T */  SA_NULL_TARGET16,
+    /*  1:E */  SA_NULL_TARGET16,
 
-    /*  2:F */  SA_NULL_TARGET,
-    /*  2:T */  SA_NULL_TARGET,
-    /*  2:E */  SA_NULL_TARGET,
+    /*  2:F */  SA_NULL_TARGET16,
+    /*  2:T */  SA_NULL_TARGET16,
+    /*  2:E */  SA_NULL_TARGET16,
 
-    /*  3:F */  SA_NULL_TARGET,
-    /*  3:T */  SA_NULL_TARGET,
-    /*  3:E */  SA_NULL_TARGET,
+    /*  3:F */  SA_NULL_TARGET16,
+    /*  3:T */  SA_NULL_TARGET16,
+    /*  3:E */  SA_NULL_TARGET16,
 
     /*  4:F */  2,
     /*  4:T */  5,
     /*  4:E */  8,
 
-    /*  5:F */  SA_NULL_TARGET,
-    /*  5:T */  SA_NULL_TARGET,
-    /*  5:E */  SA_NULL_TARGET,
+    /*  5:F */  SA_NULL_TARGET16,
+    /*  5:T */  SA_NULL_TARGET16,
+    /*  5:E */  SA_NULL_TARGET16,
 
     /*  6:F */  9,
     /*  6:T */  5,
-    /*  6:E */  SA_NULL_TARGET,
+    /*  6:E */  SA_NULL_TARGET16,
 
-    /*  7:F */  SA_NULL_TARGET,
+    /*  7:F */  SA_NULL_TARGET16,
     /*  7:T */  10,
-    /*  7:E */  SA_NULL_TARGET,
+    /*  7:E */  SA_NULL_TARGET16,
 
-    /*  8:F */  SA_NULL_TARGET,
-    /*  8:T */  SA_NULL_TARGET,
-    /*  8:E */  SA_NULL_TARGET,
+    /*  8:F */  SA_NULL_TARGET16,
+    /*  8:T */  SA_NULL_TARGET16,
+    /*  8:E */  SA_NULL_TARGET16,
 
-    /*  9:F */  SA_NULL_TARGET,
-    /*  9:T */  SA_NULL_TARGET,
-    /*  9:E */  SA_NULL_TARGET,
+    /*  9:F */  SA_NULL_TARGET16,
+    /*  9:T */  SA_NULL_TARGET16,
+    /*  9:E */  SA_NULL_TARGET16,
 
-    /* 10:F */  SA_NULL_TARGET,
-    /* 10:T */  SA_NULL_TARGET,
-    /* 10:E */  SA_NULL_TARGET,
+    /* 10:F */  SA_NULL_TARGET16,
+    /* 10:T */  SA_NULL_TARGET16,
+    /* 10:E */  SA_NULL_TARGET16,
 
-    /* 11:F */  SA_NULL_TARGET,
-    /* 11:T */  SA_NULL_TARGET,
-    /* 11:E */  SA_NULL_TARGET,
+    /* 11:F */  SA_NULL_TARGET16,
+    /* 11:T */  SA_NULL_TARGET16,
+    /* 11:E */  SA_NULL_TARGET16,
 };
 
 /* Goto table */
 const lr1_goto_tab_t test_goto_tab = {
     .state_cnt    = 12,
     .non_term_cnt = 3,
-    .impl         = &goto_tab_impl,
+    .width        = sizeof(goto_tab_impl[0]),
+    .impl.w16     = goto_tab_impl,
+};
+
+/* Goto table (direct-coded parser) */
+const lr1_goto_tab_t test_direct_goto_tab = {
+    .state_cnt    = 12,
+    .non_term_cnt = 3,
+    .width        = sizeof(goto_tab_impl[0]),
+};
+
+/**
+ *  Goto table implementation (chain rule F => T reductions skipped)
+ *
+ *  Derived by hand from the goto table above (see the header file):
+ *  T gotos to state 5 are replaced by the respective F gotos.
+ */
+static const uint16_t chain_goto_tab_impl[12 * 3] = {
+    /*  0:F */  2,
+    /*  0:T */  2,
+    /*  0:E */  1,
+
+    /*  1:F */  SA_NULL_TARGET16,
+    /*  1:T */  SA_NULL_TARGET16,
+    /*  1:E */  SA_NULL_TARGET16,
+
+    /*  2:F */  SA_NULL_TARGET16,
+    /*  2:T */  SA_NULL_TARGET16,
+    /*  2:E */  SA_NULL_TARGET16,
+
+    /*  3:F */  SA_NULL_TARGET16,
+    /*  3:T */  SA_NULL_TARGET16,
+    /*  3:E */  SA_NULL_TARGET16,
+
+    /*  4:F */  2,
+    /*  4:T */  2,
+    /*  4:E */  8,
+
+    /*  5:F */  SA_NULL_TARGET16,
+    /*  5:T */  SA_NULL_TARGET16,
+    /*  5:E */  SA_NULL_TARGET16,
+
+    /*  6:F */  9,
+    /*  6:T */  9,
+    /*  6:E */  SA_NULL_TARGET16,
+
+    /*  7:F */  SA_NULL_TARGET16,
+    /*  7:T */  10,
+    /*  7:E */  SA_NULL_TARGET16,
+
+    /*  8:F */  SA_NULL_TARGET16,
+    /*  8:T */  SA_NULL_TARGET16,
+    /*  8:E */  SA_NULL_TARGET16,
+
+    /*  9:F */  SA_NULL_TARGET16,
+    /*  9:T */  SA_NULL_TARGET16,
+    /*  9:E */  SA_NULL_TARGET16,
+
+    /* 10:F */  SA_NULL_TARGET16,
+    /* 10:T */  SA_NULL_TARGET16,
+    /* 10:E */  SA_NULL_TARGET16,
+
+    /* 11:F */  SA_NULL_TARGET16,
+    /* 11:T */  SA_NULL_TARGET16,
+    /* 11:E */  SA_NULL_TARGET16,
+};
+
+/* Goto table (chain rule F => T reductions skipped) */
+const lr1_goto_tab_t test_chain_goto_tab = {
+    .state_cnt    = 12,
+    .non_term_cnt = 3,
+    .width        = sizeof(chain_goto_tab_impl[0]),
+    .impl.w16     = chain_goto_tab_impl,
 };
 
 
@@ -1651,6 +1732,234 @@ const lr1_rule_tab_t test_rule_tab = {
 };
 
 
+/*
+ * Direct-coded parser
+ */
+
+/**
+ *  \brief  Direct-coded LR(1) parser
+ *
+ *  See \ref sa_direct_parse_fn.
+ */
+static sa_status_t lr1_parse(syxa_t *sa) {
+    assert(NULL != sa);
+
+    const la_item_t *items;
+    size_t           item_cnt;
+    size_t           state;
+    size_t           i;
+
+    sa->status = SA_OK;
+
+    /* Resume parsing in the current state */
+    switch (sa_current_state(sa)) {
+        case  0: goto state_0;
+        case  1: goto state_1;
+        case  2: goto state_2;
+        case  3: goto state_3;
+        case  4: goto state_4;
+        case  5: goto state_5;
+        case  6: goto state_6;
+        case  7: goto state_7;
+        case  8: goto state_8;
+        case  9: goto state_9;
+        case 10: goto state_10;
+        case 11: goto state_11;
+        default: return sa->status = SA_ERROR;
+    }
+
+  state_0:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 1:  /* number */
+            if (SA_OK != sa_shift(sa, 3, items + i, item_cnt)) return sa->status;
+            goto state_3;
+
+        case 5:  /* lpar */
+            if (SA_OK != sa_shift(sa, 4, items + i, item_cnt)) return sa->status;
+            goto state_4;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_1:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 2:  /* add */
+            if (SA_OK != sa_shift(sa, 6, items + i, item_cnt)) return sa->status;
+            goto state_6;
+
+        case 0:  /* EOF */
+            return sa_accept_input(sa);
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_2:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 3:  /* mul */
+            if (SA_OK != sa_shift(sa, 7, items + i, item_cnt)) return sa->status;
+            goto state_7;
+
+        case 0:  /* EOF */
+        case 2:  /* add */
+        case 4:  /* rpar */
+            if (SA_OK != sa_reduce(sa, &rule2, &state)) return sa->status;
+            goto nt_E;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_3:  /* default reduction */
+    if (SA_OK != sa_reduce(sa, &rule6, &state)) return sa->status;
+    goto nt_T;
+
+  state_4:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 1:  /* number */
+            if (SA_OK != sa_shift(sa, 3, items + i, item_cnt)) return sa->status;
+            goto state_3;
+
+        case 5:  /* lpar */
+            if (SA_OK != sa_shift(sa, 4, items + i, item_cnt)) return sa->status;
+            goto state_4;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_5:  /* default reduction */
+    if (SA_OK != sa_reduce(sa, &rule4, &state)) return sa->status;
+    goto nt_F;
+
+  state_6:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 1:  /* number */
+            if (SA_OK != sa_shift(sa, 3, items + i, item_cnt)) return sa->status;
+            goto state_3;
+
+        case 5:  /* lpar */
+            if (SA_OK != sa_shift(sa, 4, items + i, item_cnt)) return sa->status;
+            goto state_4;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_7:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 1:  /* number */
+            if (SA_OK != sa_shift(sa, 3, items + i, item_cnt)) return sa->status;
+            goto state_3;
+
+        case 5:  /* lpar */
+            if (SA_OK != sa_shift(sa, 4, items + i, item_cnt)) return sa->status;
+            goto state_4;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_8:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 2:  /* add */
+            if (SA_OK != sa_shift(sa, 6, items + i, item_cnt)) return sa->status;
+            goto state_6;
+
+        case 4:  /* rpar */
+            if (SA_OK != sa_shift(sa, 11, items + i, item_cnt)) return sa->status;
+            goto state_11;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_9:
+    if (SA_OK != sa_read_items(sa, &items, &item_cnt)) return sa->status;
+
+    for (i = 0; i < item_cnt; ++i) switch (la_item_code(items + i)) {
+        case 3:  /* mul */
+            if (SA_OK != sa_shift(sa, 7, items + i, item_cnt)) return sa->status;
+            goto state_7;
+
+        case 0:  /* EOF */
+        case 2:  /* add */
+        case 4:  /* rpar */
+            if (SA_OK != sa_reduce(sa, &rule1, &state)) return sa->status;
+            goto nt_E;
+    }
+
+    return sa->status = SA_SYNTAX_ERROR;
+
+  state_10:  /* default reduction */
+    if (SA_OK != sa_reduce(sa, &rule3, &state)) return sa->status;
+    goto nt_F;
+
+  state_11:  /* default reduction */
+    if (SA_OK != sa_reduce(sa, &rule5, &state)) return sa->status;
+    goto nt_T;
+
+  nt_F:
+    switch (state) {
+        case 0:
+            if (SA_OK != sa_goto(sa, 2)) return sa->status;
+            goto state_2;
+
+        case 4:
+            if (SA_OK != sa_goto(sa, 2)) return sa->status;
+            goto state_2;
+
+        case 6:
+            if (SA_OK != sa_goto(sa, 9)) return sa->status;
+            goto state_9;
+    }
+
+    return sa->status = SA_ERROR;
+
+  nt_T:
+    switch (state) {
+        case 0:
+            if (SA_OK != sa_goto(sa, 5)) return sa->status;
+            goto state_5;
+
+        case 4:
+            if (SA_OK != sa_goto(sa, 5)) return sa->status;
+            goto state_5;
+
+        case 6:
+            if (SA_OK != sa_goto(sa, 5)) return sa->status;
+            goto state_5;
+
+        case 7:
+            if (SA_OK != sa_goto(sa, 10)) return sa->status;
+            goto state_10;
+    }
+
+    return sa->status = SA_ERROR;
+
+  nt_E:
+    switch (state) {
+        case 0:
+            if (SA_OK != sa_goto(sa, 1)) return sa->status;
+            goto state_1;
+
+        case 4:
+            if (SA_OK != sa_goto(sa, 8)) return sa->status;
+            goto state_8;
+    }
+
+    return sa->status = SA_ERROR;
+}
+
+
 /*
  * Attribute evaluators wrappers
  */
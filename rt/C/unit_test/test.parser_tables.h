@@ -40,6 +40,15 @@
 extern const lr1_action_tab_t test_action_tab;
 
 
+/**
+ *  \brief  LR(1) action table with direct-coded parser
+ *
+ *  The parser tables are generated.
+ *  Don't change the code; change the definition, if required.
+ */
+extern const lr1_action_tab_t test_direct_action_tab;
+
+
 /**
  *  \brief  LR(1) goto table
  *
@@ -49,6 +58,28 @@ extern const lr1_action_tab_t test_action_tab;
 extern const lr1_goto_tab_t test_goto_tab;
 
 
+/**
+ *  \brief  LR(1) goto table for direct-coded parser (no implementation)
+ *
+ *  The parser tables are generated.
+ *  Don't change the code; change the definition, if required.
+ */
+extern const lr1_goto_tab_t test_direct_goto_tab;
+
+
+/**
+ *  \brief  LR(1) goto table with chain rules reductions skipped
+ *
+ *  Unlike the other tables, this one is NOT generated;
+ *  it's derived by hand from \ref test_goto_tab the same way
+ *  \c ctx-fryer-cfg2parser \c --eliminate-chain-rules does it:
+ *  gotos on \c T to state 5 (reduction by chain rule F => T)
+ *  are replaced by gotos on \c F from the same state.
+ *  Keep it in sync with \ref test_goto_tab.
+ */
+extern const lr1_goto_tab_t test_chain_goto_tab;
+
+
 /**
  *  \brief  LR(1) rules info table
  *
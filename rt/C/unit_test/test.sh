@@ -67,13 +67,49 @@ test -n "$USE_VALGRIND" && run_under_valgrind="true"
 if test "$run_under_valgrind" = "false"; then
     run_test "Source file"      test.srcfile          "-l4 test.srcfile.c"
     run_test "Lexical analyser" test.lexical_analyser "-cl4" test.lexical_analyser.input test.lexical_analyser.output
+    run_test "Lexical analyser (dense tables)" test.lexical_analyser "-cl4 -f dense" test.lexical_analyser.input test.lexical_analyser.output
+    run_test "Lexical analyser (comb tables)" test.lexical_analyser "-cl4 -f comb" test.lexical_analyser.input test.lexical_analyser.output
+    run_test "Lexical analyser (direct scanner)" test.lexical_analyser "-cl4 -f direct" test.lexical_analyser.input test.lexical_analyser.output
+    run_test "Lexical analyser (offsets only)" test.lexical_analyser "-cl4 -o" test.lexical_analyser.input test.lexical_analyser.output
+    run_test "Lexical analyser (direct scanner, offsets only)" test.lexical_analyser "-cl4 -f direct -o" test.lexical_analyser.input test.lexical_analyser.output
+    run_test "Lexical analyser (skipped item)" test.lexical_analyser "-cl4 -i 3" test.lexical_analyser.input test.lexical_analyser.skip.output
+    run_test "Lexical analyser (batch)" test.lexical_analyser "-cl4 -b 3" test.lexical_analyser.input test.lexical_analyser.batch.output
+    run_test "Lexical analyser (batch, offsets only)" test.lexical_analyser "-cl4 -b 1 -o" test.lexical_analyser.input test.lexical_analyser.batch.output
+    run_test "Lexical analyser (batch, single buffer)" test.lexical_analyser "-cl4 -b 3 -s 1" test.lexical_analyser.input test.lexical_analyser.batch.output
+    run_test "Lexical analyser (parallel)" test.lexical_analyser "-cl4 -p 4" test.lexical_analyser.input test.lexical_analyser.batch.output
+    run_test "Lexical analyser (parallel, direct scanner)" test.lexical_analyser "-cl4 -p 16 -f direct" test.lexical_analyser.input test.lexical_analyser.batch.output
+    run_test "Lexical analyser (long overruns)" test.lexical_analyser "-cl4 -s 256" test.lexical_analyser.overrun.input test.lexical_analyser.overrun.output
+    run_test "Lexical analyser (overrun linearity)" test.lexical_analyser "-l4 -r 4096"
     run_test "Syntax analyser"  test.syntax_analyser  "-l4"  test.syntax_analyser.input  test.syntax_analyser.output
+    run_test "Syntax analyser (pipelined)" test.syntax_analyser "-l4 -P 3" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (chain rules skipped)" test.syntax_analyser "-l4 -C" test.syntax_analyser.input test.syntax_analyser.chain.output
+    run_test "Syntax analyser (direct-coded)" test.syntax_analyser "-l4 -D" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (direct-coded, pipelined)" test.syntax_analyser "-l4 -D -P 3" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (semantic values)" test.syntax_analyser "-l4 -V" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (semantic values, direct-coded)" test.syntax_analyser "-l4 -V -D" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (events)" test.syntax_analyser "-l4 -E 1" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (events, batched)" test.syntax_analyser "-l4 -E 4" test.syntax_analyser.input test.syntax_analyser.output
+    run_test "Syntax analyser (events, batched, pipelined)" test.syntax_analyser "-l4 -E 4 -P 3 -D" test.syntax_analyser.input test.syntax_analyser.output
 else
     which valgrind >/dev/null || quit 2 "valgrind not found (is it installed?)"
 
     run_test_valgrind "Source file"      test.srcfile          "-l4 test.srcfile.c"
     run_test_valgrind "Lexical analyser" test.lexical_analyser "-cl4" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (dense tables)" test.lexical_analyser "-cl4 -f dense" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (comb tables)" test.lexical_analyser "-cl4 -f comb" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (direct scanner)" test.lexical_analyser "-cl4 -f direct" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (offsets only)" test.lexical_analyser "-cl4 -o" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (skipped item)" test.lexical_analyser "-cl4 -i 3" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (batch)" test.lexical_analyser "-cl4 -b 3" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (parallel)" test.lexical_analyser "-cl4 -p 4" test.lexical_analyser.input
+    run_test_valgrind "Lexical analyser (long overruns)" test.lexical_analyser "-cl4 -s 256" test.lexical_analyser.overrun.input
+    run_test_valgrind "Lexical analyser (overrun linearity)" test.lexical_analyser "-l4 -r 4096"
     run_test_valgrind "Syntax analyser"  test.syntax_analyser  "-l4"  test.syntax_analyser.input
+    run_test_valgrind "Syntax analyser (pipelined)" test.syntax_analyser "-l4 -P 3" test.syntax_analyser.input
+    run_test_valgrind "Syntax analyser (chain rules skipped)" test.syntax_analyser "-l4 -C" test.syntax_analyser.input
+    run_test_valgrind "Syntax analyser (direct-coded)" test.syntax_analyser "-l4 -D" test.syntax_analyser.input
+    run_test_valgrind "Syntax analyser (semantic values)" test.syntax_analyser "-l4 -V" test.syntax_analyser.input
+    run_test_valgrind "Syntax analyser (events, batched)" test.syntax_analyser "-l4 -E 4" test.syntax_analyser.input
 fi
 
 quit 0 "All unit tests PASSED"
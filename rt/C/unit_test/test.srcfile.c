@@ -25,14 +25,29 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "config.h"
+
 #include "test.h"
 
 #include "srcfile.h"
+#include "srcdecomp.h"
 
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#if defined HAVE_ZLIB_H && defined HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#if defined HAVE_ZSTD_H && defined HAVE_LIBZSTD
+#include <zstd.h>
+#endif
 
 
 /** Page size multiplier default */
@@ -79,6 +94,48 @@ int dump_src = 0;
     } while (0)
 
 
+/**
+ *  \brief  Check buffer contents
+ *
+ *  The buffer is compared with the source file contents
+ *  (read by std. I/O).
+ *
+ *  \param  ref     Source file (reference)
+ *  \param  buffer  Source buffer
+ *
+ *  \retval 0        if the buffer matches the source file
+ *  \retval non-zero otherwise
+ */
+int check_buffer(FILE *ref, buffer_t *buffer) {
+    size_t size = buffer_size(buffer);
+
+    /* Empty buffer (end of stream) */
+    if (0 == size) return 0;
+
+    char *data = (char *)malloc(size);
+
+    if (NULL == data) {
+        ERROR("Failed to allocate reference data buffer");
+
+        return ENOMEM;
+    }
+
+    int status = 0;
+
+    if (size != fread(data, 1, size, ref) ||
+        memcmp(data, buffer_data(buffer), size))
+    {
+        ERROR("Buffer contents doesn't match the source file");
+
+        status = EINVAL;
+    }
+
+    free(data);
+
+    return status;
+}
+
+
 /**
  *  \brief  Test source file module
  *
@@ -90,6 +147,14 @@ int dump_src = 0;
 int test(srcfile_t *src_file) {
     SRCF_IFACE_RETURN_ON_ERROR(srcfile_open, src_file);
 
+    FILE *ref = fopen(srcfile_name(src_file), "r");
+
+    if (NULL == ref) {
+        ERROR("Failed to open reference source file");
+
+        return errno;
+    }
+
     size_t buffer_cnt = 0;
 
     int done;
@@ -103,6 +168,8 @@ int test(srcfile_t *src_file) {
 
         DEBUG("Got buffer #%zu, size: %zu", buffer_cnt, buffer_size(buffer));
 
+        SRCF_IFACE_RETURN_ON_ERROR(check_buffer, ref, buffer);
+
         /* Dump source */
         if (dump_src) {
             fprintf(stdout, "%.*s", (int)buffer_size(buffer), buffer_data(buffer));
@@ -115,6 +182,8 @@ int test(srcfile_t *src_file) {
 
     INFO("Got %zu buffers", buffer_cnt);
 
+    fclose(ref);
+
     SRCF_IFACE_RETURN_ON_ERROR(srcfile_close, src_file);
 
     return 0;
@@ -177,6 +246,79 @@ int test_block_mode(const char *src_file_name, size_t block_size) {
 }
 
 
+/**
+ *  \brief  Test source file in block mode with shared block pool
+ *
+ *  The source file is read twice using the same block pool;
+ *  the 2nd reading must not allocate any blocks.
+ *
+ *  \param  src_file_name  Source file name
+ *  \param  block_size     Block size
+ *  \param  direct_io      Use direct I/O
+ *
+ *  \retval 0        in case of success
+ *  \retval non-zero otherwise
+ */
+int test_block_pool(const char *src_file_name, size_t block_size, int direct_io) {
+    /* Direct I/O requires aligned blocks */
+    size_t align = 0;
+
+    if (direct_io) {
+        align      = srcfile_page_size();
+        block_size = (block_size + align - 1) / align * align;
+    }
+
+    srcfile_block_pool_t *pool = srcfile_block_pool_create(block_size, align, 4);
+
+    if (NULL == pool) {
+        ERROR("Failed to create block pool");
+
+        return ENOMEM;
+    }
+
+    int    status    = 0;
+    size_t block_cnt = 0;
+    int    i         = 0;
+
+    for (; i < 2 && !status; ++i) {
+        srcfile_t src_file;
+
+        srcfile_create(&src_file, src_file_name, SRCFILE_SEG_BLOCK, block_size);
+
+        status = srcfile_set_block_pool(&src_file, pool, direct_io);
+
+        if (ENOTSUP == status) {
+            WARN("Direct I/O isn't supported");
+
+            status = srcfile_set_block_pool(&src_file, pool, 0);
+        }
+
+        if (status) {
+            ERROR("Failed to set block pool: %d", status);
+        }
+        else {
+            status = test(&src_file);
+        }
+
+        srcfile_destroy(&src_file);
+
+        /* No more blocks are allocated on repeated use */
+        if (i && objpool_cnt(&pool->blocks) != block_cnt) {
+            ERROR("Blocks were allocated (%zu, was %zu)",
+                  objpool_cnt(&pool->blocks), block_cnt);
+
+            status = EINVAL;
+        }
+
+        block_cnt = objpool_cnt(&pool->blocks);
+    }
+
+    srcfile_block_pool_release(pool);
+
+    return status;
+}
+
+
 /**
  *  \brief  Test source file in line mode
  *
@@ -187,19 +329,431 @@ int test_block_mode(const char *src_file_name, size_t block_size) {
  *  C++ way of automatic object destruction upon leaving scope).
  *
  *  \param  src_file_name  Source file name
+ *  \param  block_size     Lines block size (0 means default)
+ *
+ *  \retval 0        in case of success
+ *  \retval non-zero otherwise
+ */
+int test_line_mode(const char *src_file_name, size_t block_size) {
+    srcfile_t src_file;
+
+    /* Small blocks make lines span them */
+    srcfile_create(&src_file, src_file_name, SRCFILE_SEG_LINE, block_size);
+
+    int status = test(&src_file);
+
+    srcfile_destroy(&src_file);
+
+    return status;
+}
+
+
+/**
+ *  \brief  Test source file in whole file mapping mode
+ *
+ *  The function is the source file object construction
+ *  wrapper (for whole file mapping mode).
+ *  It also makes sure that the destructor is called
+ *  no matter what happens during the test (thus simuating
+ *  C++ way of automatic object destruction upon leaving scope).
+ *
+ *  \param  src_file_name    Source file name
+ *  \param  window_size_mul  Window size multiplier (0 means whole file)
+ *  \param  map_flags        Mapping flags
+ *
+ *  \retval 0        in case of success
+ *  \retval non-zero otherwise
+ */
+int test_whole_mode(const char *src_file_name, size_t window_size_mul, int map_flags) {
+    srcfile_t src_file;
+
+    srcfile_create(&src_file, src_file_name, SRCFILE_SEG_WHOLE, window_size_mul, map_flags);
+
+    int status = test(&src_file);
+
+    srcfile_destroy(&src_file);
+
+    return status;
+}
+
+
+/**
+ *  \brief  Test source file in stream mode
+ *
+ *  The function is the source file object construction
+ *  wrapper (for stream segmentation mode).
+ *  The stream is either the file opened by the source file object
+ *  or a pipe; in the latter case, a child process writes
+ *  the source file to the pipe.
+ *
+ *  \param  src_file_name  Source file name
+ *  \param  block_size     Block size
+ *  \param  use_pipe       Read the source from pipe
  *
  *  \retval 0        in case of success
  *  \retval non-zero otherwise
  */
-int test_line_mode(const char *src_file_name) {
+int test_stream_mode(const char *src_file_name, size_t block_size, int use_pipe) {
+    int fd = -1;
+
+    pid_t writer = -1;
+
+    if (use_pipe) {
+        int pipe_fds[2];
+
+        if (pipe(pipe_fds)) {
+            ERROR("Failed to create pipe");
+
+            return errno;
+        }
+
+        writer = fork();
+
+        if (-1 == writer) {
+            ERROR("Failed to fork writer");
+
+            return errno;
+        }
+
+        /* Writer: copy the file to the pipe (in small chunks) */
+        if (0 == writer) {
+            close(pipe_fds[0]);
+
+            FILE *src = fopen(src_file_name, "r");
+
+            if (NULL == src) _exit(1);
+
+            char   chunk[100];
+            size_t chunk_size;
+
+            while (0 < (chunk_size = fread(chunk, 1, sizeof(chunk), src)))
+                if (chunk_size != (size_t)write(pipe_fds[1], chunk, chunk_size))
+                    _exit(1);
+
+            _exit(0);
+        }
+
+        close(pipe_fds[1]);
+
+        fd = pipe_fds[0];
+    }
+
     srcfile_t src_file;
 
-    srcfile_create(&src_file, src_file_name, SRCFILE_SEG_LINE);
+    srcfile_create(&src_file, src_file_name, SRCFILE_SEG_STREAM, block_size, fd);
 
     int status = test(&src_file);
 
     srcfile_destroy(&src_file);
 
+    if (use_pipe) {
+        close(fd);
+
+        int writer_status;
+
+        if (-1 == waitpid(writer, &writer_status, 0) ||
+            !WIFEXITED(writer_status) || WEXITSTATUS(writer_status))
+        {
+            ERROR("Pipe writer failed");
+
+            if (!status) status = EINVAL;
+        }
+    }
+
+    return status;
+}
+
+
+/**
+ *  \brief  Compress source file (gzip)
+ *
+ *  The file is compressed as 2 concatenated gzip members
+ *  (the decompression must handle that transparently).
+ *
+ *  \param  src_file_name  Source file name
+ *  \param  gz_file_name   Compressed file name template (see \c mkstemp)
+ *
+ *  \retval 0        in case of success
+ *  \retval ENOTSUP  if gzip compression isn't supported
+ *  \retval non-zero otherwise
+ */
+int gzip_file(const char *src_file_name, char *gz_file_name) {
+#if defined HAVE_ZLIB_H && defined HAVE_LIBZ
+    FILE *src = fopen(src_file_name, "r");
+
+    if (NULL == src) {
+        ERROR("Failed to open source file");
+
+        return errno;
+    }
+
+    fseek(src, 0, SEEK_END);
+    long half = ftell(src) / 2;
+    fseek(src, 0, SEEK_SET);
+
+    int fd = mkstemp(gz_file_name);
+
+    if (-1 == fd) {
+        ERROR("Failed to create compressed file");
+
+        fclose(src);
+
+        return errno;
+    }
+
+    close(fd);
+
+    int status = 0;
+
+    for (int member = 0; member < 2 && !status; ++member) {
+        gzFile gz = gzopen(gz_file_name, member ? "ab" : "wb");
+
+        if (NULL == gz) {
+            ERROR("Failed to open compressed file");
+
+            status = EIO;
+
+            break;
+        }
+
+        char   chunk[100];
+        size_t chunk_size;
+        long   to_go = member ? -1 : half;
+
+        while (to_go && 0 < (chunk_size = fread(chunk, 1,
+            0 < to_go && to_go < sizeof(chunk) ? (size_t)to_go : sizeof(chunk), src)))
+        {
+            if (chunk_size != gzwrite(gz, chunk, chunk_size)) {
+                ERROR("Failed to write compressed file");
+
+                status = EIO;
+
+                break;
+            }
+
+            if (0 < to_go) to_go -= chunk_size;
+        }
+
+        if (Z_OK != gzclose(gz) && !status) status = EIO;
+    }
+
+    fclose(src);
+
+    return status;
+#else
+    return ENOTSUP;
+#endif
+}
+
+
+/**
+ *  \brief  Compress source file (Zstandard)
+ *
+ *  The file is compressed as 2 concatenated Zstandard frames
+ *  (the decompression must handle that transparently).
+ *
+ *  \param  src_file_name  Source file name
+ *  \param  zst_file_name  Compressed file name template (see \c mkstemp)
+ *
+ *  \retval 0        in case of success
+ *  \retval ENOTSUP  if Zstandard compression isn't supported
+ *  \retval non-zero otherwise
+ */
+int zstd_file(const char *src_file_name, char *zst_file_name) {
+#if defined HAVE_ZSTD_H && defined HAVE_LIBZSTD
+    FILE *src = fopen(src_file_name, "r");
+
+    if (NULL == src) {
+        ERROR("Failed to open source file");
+
+        return errno;
+    }
+
+    fseek(src, 0, SEEK_END);
+    size_t size = (size_t)ftell(src);
+    fseek(src, 0, SEEK_SET);
+
+    char *data = (char *)malloc(size + 1);  /* non-NULL even if empty */
+
+    if (NULL == data) {
+        ERROR("Failed to allocate source data");
+
+        fclose(src);
+
+        return ENOMEM;
+    }
+
+    int status = 0;
+
+    if (size != fread(data, 1, size, src)) {
+        ERROR("Failed to read source file");
+
+        status = EIO;
+    }
+
+    fclose(src);
+
+    int fd = status ? -1 : mkstemp(zst_file_name);
+
+    if (!status && -1 == fd) {
+        ERROR("Failed to create compressed file");
+
+        status = errno;
+    }
+
+    size_t half = size / 2;
+
+    for (int frame = 0; frame < 2 && !status; ++frame) {
+        const char *in      = data + (frame ? half : 0);
+        size_t      in_size = frame ? size - half : half;
+
+        size_t bound = ZSTD_compressBound(in_size);
+        char  *out   = (char *)malloc(bound);
+
+        if (NULL == out) {
+            ERROR("Failed to allocate compressed frame");
+
+            status = ENOMEM;
+
+            break;
+        }
+
+        size_t out_size = ZSTD_compress(out, bound, in, in_size, 1);
+
+        if (ZSTD_isError(out_size)) {
+            ERROR("Failed to compress frame: %s", ZSTD_getErrorName(out_size));
+
+            status = EIO;
+        }
+        else if ((ssize_t)out_size != write(fd, out, out_size)) {
+            ERROR("Failed to write compressed file");
+
+            status = EIO;
+        }
+
+        free(out);
+    }
+
+    if (-1 != fd) close(fd);
+
+    free(data);
+
+    return status;
+#else
+    return ENOTSUP;
+#endif
+}
+
+
+/**
+ *  \brief  Test decompressing source
+ *
+ *  The (decompressed) source is compared with the original file.
+ *  Compressed files are created by \ref gzip_file or \ref zstd_file;
+ *  the test is skipped if the format isn't supported by the build.
+ *
+ *  \param  src_file_name  Source file name
+ *  \param  block_size     Block size
+ *  \param  format         Compression format of the source file
+ *  \param  threaded       Decompress in separate thread
+ *
+ *  \retval 0        in case of success
+ *  \retval non-zero otherwise
+ */
+int test_decomp_mode(const char *src_file_name, size_t block_size, srcdecomp_format_t format, int threaded) {
+    char comp_file_name[] = "test.srcfile.comp.XXXXXX";
+
+    const char *file_name = src_file_name;
+    int         compress  = SRCDECOMP_NONE != format;
+
+    if (compress) {
+        int status = SRCDECOMP_ZSTD == format
+            ? zstd_file(src_file_name, comp_file_name)
+            : gzip_file(src_file_name, comp_file_name);
+
+        if (ENOTSUP == status) {
+            WARN("%s isn't supported, test skipped",
+                 SRCDECOMP_ZSTD == format ? "Zstandard" : "gzip");
+
+            return 0;
+        }
+
+        if (status) return status;
+
+        file_name = comp_file_name;
+    }
+
+    /* Compressed source is read as stream in threaded mode */
+    srcfile_t src_file;
+
+    if (threaded)
+        srcfile_create(&src_file, file_name, SRCFILE_SEG_STREAM, block_size, -1);
+    else
+        srcfile_create(&src_file, file_name, SRCFILE_SEG_BLOCK, block_size);
+
+    srcdecomp_t dec;
+
+    srcdecomp_create(&dec, &src_file, SRCDECOMP_AUTO, block_size, threaded);
+
+    int status = srcdecomp_open(&dec);
+
+    if (status)
+        ERROR("Failed to open decompressing source: %d: %s",
+              status, strerror(status));
+
+    else if (srcdecomp_format(&dec) != format) {
+        ERROR("Compression format wasn't detected correctly");
+
+        status = EINVAL;
+    }
+
+    FILE *ref = NULL;
+
+    if (!status && NULL == (ref = fopen(src_file_name, "r"))) {
+        ERROR("Failed to open reference source file");
+
+        status = errno;
+    }
+
+    size_t buffer_cnt = 0;
+
+    for (int done = 0; !status && !done; ) {
+        buffer_t *buffer;
+
+        status = srcdecomp_next_buffer(&dec, &buffer, &done);
+
+        if (status) {
+            ERROR("Failed to get decompressed buffer: %d: %s",
+                  status, strerror(status));
+
+            break;
+        }
+
+        ++buffer_cnt;
+
+        DEBUG("Got buffer #%zu, size: %zu", buffer_cnt, buffer_size(buffer));
+
+        status = check_buffer(ref, buffer);
+
+        buffer_destroy(buffer);
+    }
+
+    /* The whole source must have been provided */
+    if (!status && EOF != fgetc(ref)) {
+        ERROR("Decompressed source is incomplete");
+
+        status = EINVAL;
+    }
+
+    INFO("Got %zu buffers", buffer_cnt);
+
+    if (NULL != ref) fclose(ref);
+
+    srcdecomp_destroy(&dec);
+    srcfile_destroy(&src_file);
+
+    if (compress) unlink(comp_file_name);
+
     return status;
 }
 
@@ -239,6 +793,14 @@ void usage(const char *this) {
     LOG("");
     LOG("In line mode, lines ended ");
     LOG("");
+    LOG("In stream mode, blocks are read from a stream (the file or a pipe).");
+    LOG("");
+    LOG("In decompression mode, the source file (and its gzip and zstd-compressed copies)");
+    LOG("is read via the decompressing source, in the same and in separate thread.");
+    LOG("");
+    LOG("In whole mode, the whole source file is mapped to memory at once;");
+    LOG("it's tested both in one buffer and in windows of the page size multiple.");
+    LOG("");
 }
 
 
@@ -312,7 +874,25 @@ int main(int argc, char * const argv[]) {
     /* Run test cases */
     TEST_CASE("Page mode",  test_page_mode,  src_file_name, page_size_mul);
     TEST_CASE("Block mode", test_block_mode, src_file_name, block_size);
-    TEST_CASE("Line mode",  test_line_mode,  src_file_name);
+    TEST_CASE("Block mode (pooled)", test_block_pool, src_file_name, block_size, 0);
+    TEST_CASE("Block mode (direct I/O)", test_block_pool, src_file_name, block_size, 1);
+    TEST_CASE("Line mode",  test_line_mode,  src_file_name, 0);
+    TEST_CASE("Line mode (small blocks)", test_line_mode, src_file_name, 16);
+    TEST_CASE("Stream mode", test_stream_mode, src_file_name, block_size, 0);
+    TEST_CASE("Stream mode (pipe)", test_stream_mode, src_file_name, block_size, 1);
+    TEST_CASE("Whole mode", test_whole_mode, src_file_name, 0, 0);
+    TEST_CASE("Whole mode (windows)", test_whole_mode, src_file_name, page_size_mul,
+              SRCFILE_MAP_POPULATE | SRCFILE_MAP_HUGEPAGES);
+    TEST_CASE("Decompression (uncompressed)", test_decomp_mode, src_file_name, block_size,
+              SRCDECOMP_NONE, 0);
+    TEST_CASE("Decompression (gzip)", test_decomp_mode, src_file_name, block_size,
+              SRCDECOMP_GZIP, 0);
+    TEST_CASE("Decompression (gzip, threaded)", test_decomp_mode, src_file_name, block_size,
+              SRCDECOMP_GZIP, 1);
+    TEST_CASE("Decompression (zstd)", test_decomp_mode, src_file_name, block_size,
+              SRCDECOMP_ZSTD, 0);
+    TEST_CASE("Decompression (zstd, threaded)", test_decomp_mode, src_file_name, block_size,
+              SRCDECOMP_ZSTD, 1);
 
     return 0;
 }
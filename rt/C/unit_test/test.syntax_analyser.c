@@ -34,6 +34,7 @@
 #include "fsa.h"
 #include "lexical_analyser.h"
 #include "syntax_analyser.h"
+#include "sa_pipeline.h"
 
 #include <assert.h>
 #include <stdlib.h>
@@ -59,13 +60,50 @@ static char   *line            = NULL;  /**< Input line                    */
 static int     quiet           = 0;     /**< Non-null means no printout    */
 static int     compact         = 0;     /**< Non-null means compact prnout */
 static size_t  stack_cap_limit = 0;     /**< PDA stack capacity limit      */
+static size_t  pipe_buff_size  = 0;     /**< Pipelined mode buffer size    */
+static int     chain_skip      = 0;     /**< Skip chain rules reductions   */
+static int     direct          = 0;     /**< Use direct-coded parser       */
+static int     values          = 0;     /**< Compute semantic values       */
+static size_t  event_ring_size = 0;     /**< Parsing events ring size      */
+
+
+/** Pipelined mode source (the line split to buffers) */
+typedef struct {
+    const char *data;  /**< Source data      */
+    size_t      size;  /**< Source data size */
+    size_t      pos;   /**< Position         */
+} pipe_source_t;
+
+
+/** Parsing events log (derivation is taken from it) */
+typedef struct {
+    const char *line;     /**< Input line           */
+    size_t     *rules;    /**< Reductions           */
+    size_t      cnt;      /**< Reductions count     */
+    size_t      cap;      /**< Reductions capacity  */
+    size_t      batches;  /**< Handler calls count  */
+} event_log_t;
 
 
 /*
  * Static functions declarations
  */
 
-static int parse_test(syxa_t *syxa);
+static int parse_test(syxa_t *syxa, sa_pipeline_t *pipe, event_log_t *event_log);
+
+static int value_number(void **value, const la_item_t *item, void *null);
+
+static int value_sum(void **value, void *rhs[], void *null);
+
+static int value_mul(void **value, void *rhs[], void *null);
+
+static int value_par(void **value, void *rhs[], void *null);
+
+static void value_destroy(void *value, void *null);
+
+static int event_handler(sa_event_t *events, size_t event_cnt, void *log);
+
+static int pipe_source_next(void *source, buffer_t **buffer, int *last);
 
 static void line_cleanup(void *null, char *line, size_t size);
 
@@ -76,29 +114,77 @@ static void usage(const char *this);
 static void finalise(void) __attribute__((destructor));
 
 
+/**
+ *  \brief  Semantic values handlers
+ *
+ *  The expression value is computed the same way as the parse tree
+ *  root attribute.
+ */
+static const sa_value_tab_t value_tab = {
+    .shift    = value_number,
+    .destroy  = value_destroy,
+    .rule_cnt = 7,
+    .reduce   = {
+        /* 0: _E => E            */  NULL,
+        /* 1:  E => E add F      */  value_sum,
+        /* 2:  E => F            */  NULL,
+        /* 3:  F => F mul T      */  value_mul,
+        /* 4:  F => T            */  NULL,
+        /* 5:  T => lpar E rpar  */  value_par,
+        /* 6:  T => number       */  NULL,
+    }
+};
+
+
 /**
  *  \brief  Perform syntax analysis test
  *
- *  Parse the input.
+ *  Parse the input (in pipeline, if provided).
+ *  If parsing events are delivered, the derivation is taken
+ *  from the events log (the reduction log is disabled).
  *
- *  \param  syxa     Syntax analyser
+ *  \param  syxa       Syntax analyser
+ *  \param  pipe       Syntax analysis pipeline (or \c NULL)
+ *  \param  event_log  Parsing events log (or \c NULL)
  *
  *  \retval 0      on success
  *  \retval EINVAL if the the lexical analyser failed
  */
-static int parse_test(syxa_t *syxa) {
+static int parse_test(syxa_t *syxa, sa_pipeline_t *pipe, event_log_t *event_log) {
     int status = 0;
 
-    sa_status_t parser_status = sa_parse(syxa);
+    sa_status_t parser_status = NULL != pipe
+                              ? sa_pipeline_parse(pipe)
+                              : sa_parse(syxa);
 
     size_t  derivation_len;
-    size_t *derivation = sa_derivation(syxa, &derivation_len);
-
-    assert(NULL != derivation);
+    size_t *derivation;
 
     size_t i = 0;
 
-    for (; i < derivation_len; ++i)
+    if (NULL != event_log) {
+        derivation_len = event_log->cnt;
+        derivation     = event_log->rules;
+
+        event_log->rules = NULL;
+
+        /* Reductions sequence is reversed derivation */
+        for (; i < derivation_len / 2; ++i) {
+            size_t rule = derivation[i];
+
+            derivation[i] = derivation[derivation_len - 1 - i];
+            derivation[derivation_len - 1 - i] = rule;
+        }
+
+        DEBUG("Parsing events delivered in %zu batches", event_log->batches);
+    }
+    else {
+        derivation = sa_derivation(syxa, &derivation_len);
+
+        assert(NULL != derivation);
+    }
+
+    for (i = 0; i < derivation_len; ++i)
         fprintf(stdout, "%zu ", derivation[i]);
 
     switch (parser_status) {
@@ -108,6 +194,13 @@ static int parse_test(syxa_t *syxa) {
                 INFO("The input was accepted by the parser");
 
                 fprintf(stdout, ":-)");
+
+                /* Parsing accepted input again must be a no-op */
+                if (NULL == pipe && SA_OK != sa_parse(syxa)) {
+                    ERROR("Parsing after the input acceptance failed");
+
+                    status = EINVAL;
+                }
             }
 
             /* ??? */
@@ -162,12 +255,200 @@ static int parse_test(syxa_t *syxa) {
         else {
             ERROR("An attribute evaluation wasn't successful: %d", eval_status);
         }
+
+        /* Semantic value must match the attribute */
+        if (values && sa_accept(syxa)) {
+            double *sem_value = (double *)sa_handover_value(syxa);
+
+            assert(NULL != sem_value);
+
+            if (ATTR_EVAL_OK == eval_status && *sem_value != *(double *)value) {
+                ERROR("The semantic value %g doesn't match the attribute", *sem_value);
+
+                status = EINVAL;
+            }
+
+            free(sem_value);
+        }
     }
 
     return status;
 }
 
 
+/**
+ *  \brief  Number semantic value
+ *
+ *  \param  value  Value
+ *  \param  item   Lexical item
+ *  \param  null   Unused argument
+ *
+ *  \retval 0      on success
+ *  \retval ENOMEM on memory error
+ */
+static int value_number(void **value, const la_item_t *item, void *null) {
+    /* Other terminals have no value */
+    if (LEXI_number != la_item_code(item)) return 0;
+
+    la_item_t copy;
+
+    la_item_copy(&copy, item);
+
+    size_t      length;
+    const char *token = la_item_token(&copy, &length);
+
+    char *c_str = NULL != token ? strndup(token, length) : NULL;
+
+    la_item_destroy(&copy);
+
+    if (NULL == c_str) return ENOMEM;
+
+    *value = malloc(sizeof(double));
+
+    if (NULL != *value) *(double *)*value = atof(c_str);
+
+    free(c_str);
+
+    return NULL != *value ? 0 : ENOMEM;
+}
+
+
+/**
+ *  \brief  E => E add F semantic value
+ *
+ *  \param  value  Value
+ *  \param  rhs    Right-hand side values
+ *  \param  null   Unused argument
+ *
+ *  \retval 0
+ */
+static int value_sum(void **value, void *rhs[], void *null) {
+    *(double *)rhs[0] += *(double *)rhs[2];
+
+    free(rhs[2]);
+
+    *value = rhs[0];
+
+    return 0;
+}
+
+
+/**
+ *  \brief  F => F mul T semantic value
+ *
+ *  \param  value  Value
+ *  \param  rhs    Right-hand side values
+ *  \param  null   Unused argument
+ *
+ *  \retval 0
+ */
+static int value_mul(void **value, void *rhs[], void *null) {
+    *(double *)rhs[0] *= *(double *)rhs[2];
+
+    free(rhs[2]);
+
+    *value = rhs[0];
+
+    return 0;
+}
+
+
+/**
+ *  \brief  T => lpar E rpar semantic value
+ *
+ *  \param  value  Value
+ *  \param  rhs    Right-hand side values
+ *  \param  null   Unused argument
+ *
+ *  \retval 0
+ */
+static int value_par(void **value, void *rhs[], void *null) {
+    *value = rhs[1];
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Semantic value destructor
+ *
+ *  \param  value  Value
+ *  \param  null   Unused argument
+ */
+static void value_destroy(void *value, void *null) {
+    free(value);
+}
+
+
+/**
+ *  \brief  Parsing events handler
+ *
+ *  Reductions are logged, shifted tokens are checked against the input.
+ *
+ *  \param  events     Events
+ *  \param  event_cnt  Events count
+ *  \param  log        Parsing events log
+ *
+ *  \retval 0      on success
+ *  \retval EINVAL if a token doesn't match the input
+ *  \retval ENOMEM on memory error
+ */
+static int event_handler(sa_event_t *events, size_t event_cnt, void *log) {
+    event_log_t *event_log = (event_log_t *)log;
+
+    assert(NULL != event_log);
+    assert(0 < event_cnt && event_cnt <= event_ring_size);
+
+    ++event_log->batches;
+
+    size_t i = 0;
+
+    for (; i < event_cnt; ++i) {
+        sa_event_t *event = events + i;
+
+        switch (event->type) {
+            case SA_EVENT_SHIFT: {
+                size_t      len;
+                const char *token = la_item_token(&event->item, &len);
+
+                if (NULL == token) return ENOMEM;
+
+                size_t offset = la_item_token_offset(&event->item);
+
+                if (memcmp(event_log->line + offset, token, len)) {
+                    ERROR("Shifted token at %zu doesn't match the input", offset);
+
+                    return EINVAL;
+                }
+
+                DEBUX("Shifted token \"%.*s\"", (int)len, token);
+
+                break;
+            }
+
+            case SA_EVENT_REDUCE:
+                if (event_log->cnt == event_log->cap) {
+                    size_t cap = event_log->cap ? 2 * event_log->cap : 16;
+
+                    size_t *rules = (size_t *)realloc(event_log->rules,
+                        cap * sizeof(size_t));
+
+                    if (NULL == rules) return ENOMEM;
+
+                    event_log->rules = rules;
+                    event_log->cap   = cap;
+                }
+
+                event_log->rules[event_log->cnt++] = event->rule;
+
+                break;
+        }
+    }
+
+    return 0;
+}
+
+
 /**
  *  \brief  Cleanup routine for input line
  *
@@ -182,6 +463,52 @@ static void line_cleanup(void *null, char *line, size_t size) {
 }
 
 
+/**
+ *  \brief  Pipelined mode source buffers provider
+ *
+ *  Provides copies of the source split to buffers of the required size.
+ *
+ *  \param  source  Source (\ref pipe_source_t)
+ *  \param  buffer  Source buffer
+ *  \param  last    Last bit flag
+ *
+ *  \retval 0       on success
+ *  \retval ENODATA at end of source
+ *  \retval ENOMEM  on memory error
+ */
+static int pipe_source_next(void *source, buffer_t **buffer, int *last) {
+    pipe_source_t *src = (pipe_source_t *)source;
+
+    if (src->pos >= src->size && 0 < src->size) return ENODATA;
+
+    size_t size = src->size - src->pos;
+
+    if (size > pipe_buff_size) size = pipe_buff_size;
+
+    char *data = (char *)malloc(size + 1);  /* empty source is 1 empty buffer */
+
+    if (NULL == data) return ENOMEM;
+
+    memcpy(data, src->data + src->pos, size);
+
+    src->pos += size;
+
+    *last = src->pos >= src->size;
+
+    *buffer = buffer_create(data, size, line_cleanup, NULL, *last);
+
+    if (NULL == *buffer) {
+        free(data);
+
+        return ENOMEM;
+    }
+
+    if (0 == src->size) src->pos = 1;  /* so that ENODATA follows */
+
+    return 0;
+}
+
+
 /**
  *  \brief  Parse input line
  *
@@ -206,17 +533,77 @@ static int parse_line(const char *line, size_t line_len) {
     /* Create syntax analyser */
     syxa_t syxa;
 
+    const lr1_action_tab_t *action_tab =
+        direct ? &test_direct_action_tab : &test_action_tab;
+
+    const lr1_goto_tab_t *goto_tab =
+        direct     ? &test_direct_goto_tab :
+        chain_skip ? &test_chain_goto_tab  : &test_goto_tab;
+
     if (NULL == sa_create(&syxa,
                           &test_fsa, LEXICNT,
-                          &test_action_tab, &test_goto_tab,
+                          action_tab,       goto_tab,
                           &test_rule_tab,   &test_attribute_tab,
-                          1, stack_cap_limit, 1, 1, 0, 1))
+                          1, stack_cap_limit,
+                          0 == event_ring_size, 1, 0, 1))
     {
         ERROR("Failed to create parser");
 
         return -1;
     }
 
+    if (values && sa_set_value_tab(&syxa, &value_tab, NULL)) {
+        ERROR("Failed to enable semantic values");
+
+        sa_destroy(&syxa);
+
+        return -1;
+    }
+
+    /* Deliver parsing events (in batches unless the ring size is 1) */
+    event_log_t  event_log = { line, NULL, 0, 0, 0 };
+    event_log_t *events    = NULL;
+    sa_event_t  *ring      = NULL;
+
+    if (event_ring_size) {
+        if (1 < event_ring_size) {
+            ring = (sa_event_t *)malloc(event_ring_size * sizeof(sa_event_t));
+
+            assert(NULL != ring);
+        }
+
+        sa_set_event_handler(&syxa, &event_handler, &event_log,
+            ring, 1 < event_ring_size ? event_ring_size : 0);
+
+        events = &event_log;
+    }
+
+    /* Parse line in pipeline */
+    if (pipe_buff_size) {
+        pipe_source_t source = { line, line_len, 0 };
+
+        sa_pipeline_t pipe;
+
+        if (NULL == sa_pipeline_create(&pipe, &syxa, &pipe_source_next, &source, 2)) {
+            ERROR("Failed to create pipeline");
+
+            sa_destroy(&syxa);
+            free(ring);
+
+            return -1;
+        }
+
+        status = parse_test(&syxa, &pipe, events);
+
+        sa_pipeline_destroy(&pipe);
+        sa_destroy(&syxa);
+
+        free(event_log.rules);
+        free(ring);
+
+        return status;
+    }
+
     /* Push line */
     char *line_copy = strdup(line);
 
@@ -231,12 +618,15 @@ static int parse_line(const char *line, size_t line_len) {
 
     /* Test syntax analyser */
     else {
-        status = parse_test(&syxa);
+        status = parse_test(&syxa, NULL, events);
     }
 
     /* Destroy syntax analyser */
     sa_destroy(&syxa);
 
+    free(event_log.rules);
+    free(ring);
+
     return status;
 }
 
@@ -258,6 +648,11 @@ static void usage(const char *this) {
     LOG("    -s <stack limit>    PDA stack capacity limit (0 means none), default: %zu", stack_cap_limit);
     LOG("    -l <log level>      set log level, default: %d (%s)", DEFAULT_LOG_LEVEL, log_lvl2str(DEFAULT_LOG_LEVEL));
     LOG("    -S <RNG seed>       set random number generator seed");
+    LOG("    -P <buffer size>    parse in pipeline, source split to buffers of the size");
+    LOG("    -C                  use goto table skipping chain rules reductions");
+    LOG("    -D                  use direct-coded parser");
+    LOG("    -V                  compute semantic values (checked against attributes)");
+    LOG("    -E <ring size>      deliver parsing events (in batches of the size)");
     LOG("");
     LOG("Log level is an inverted threshold for message levels.");
     LOG("The lower it is, the less output is produced.");
@@ -289,7 +684,7 @@ int main(int argc, char * const argv[]) {
 
     int opt;
 
-    while (-1 != (opt = getopt(argc, argv, "hqcs:l:S:"))) {
+    while (-1 != (opt = getopt(argc, argv, "hqcCDVs:l:S:P:E:"))) {
         switch (opt) {
             case 'h':
                 usage(argv[0]);
@@ -322,6 +717,31 @@ int main(int argc, char * const argv[]) {
 
                 break;
 
+            case 'P':
+                pipe_buff_size = (size_t)atoi(optarg);
+
+                break;
+
+            case 'C':
+                chain_skip = 1;
+
+                break;
+
+            case 'D':
+                direct = 1;
+
+                break;
+
+            case 'V':
+                values = 1;
+
+                break;
+
+            case 'E':
+                event_ring_size = (size_t)atoi(optarg);
+
+                break;
+
             default:
                 FATAL("Failed to process options");
 
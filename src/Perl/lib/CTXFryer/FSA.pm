@@ -56,6 +56,15 @@ sub desc($@) {
 }
 
 
+sub skip($@) {
+    my $this = shift;
+
+    @_ and $this->{_skip} = [ @_ ];
+
+    return @{$this->{_skip} || []};
+}
+
+
 sub root($) {
     my $this = shift;
 
@@ -823,6 +832,189 @@ sub minimise($) {
 }
 
 
+sub byteClasses($) {
+    my $this = shift;
+
+    my @states = $this->_state();
+
+    # Bytes that have the same transitions in all states form a class
+    # Note that class 0 is reserved for bytes with no transitions at all
+    my %class_ids = (join(",", map("", @states)) => 0);
+    my @class_map;
+
+    foreach my $char (@CTXFryer::FSA::Symbol::ASCII::all) {
+        my $symbol = new CTXFryer::FSA::Symbol::ASCII($char);
+
+        my $signature = join(",", map {
+            my $target = $_->trans($symbol);
+
+            defined $target ? $target->id() : "";
+        } @states);
+
+        my $class = $class_ids{$signature};
+
+        unless (defined $class) {
+            $class = scalar(keys %class_ids);
+
+            # Class IDs must fit in a byte (see fsa_comb_t)
+            $class < 256
+            or FATAL("Too many byte classes for comb-vector transitions");
+
+            $class_ids{$signature} = $class;
+        }
+
+        push(@class_map, $class);
+    }
+
+    DEBUG("Byte class map: %s", \@class_map);
+
+    return @class_map;
+}
+
+
+sub comb($) {
+    my $this = shift;
+
+    my @class_map = $this->byteClasses();
+    my $class_cnt = 1;
+    my @class_chr;
+
+    # Get class count and class representants
+    for (my $ord = 0; $ord < @class_map; ++$ord) {
+        my $class = $class_map[$ord];
+
+        $class < $class_cnt or $class_cnt = $class + 1;
+
+        defined $class_chr[$class]
+        or $class_chr[$class] = $CTXFryer::FSA::Symbol::ASCII::all[$ord];
+    }
+
+    # Transition table rows (by classes)
+    my @rows;
+
+    foreach my $state ($this->_state()) {
+        my %row;
+
+        for (my $class = 1; $class < $class_cnt; ++$class) {
+            my $target = $state->trans(new CTXFryer::FSA::Symbol::ASCII($class_chr[$class]));
+
+            defined $target and $row{$class} = $target;
+        }
+
+        push(@rows, [ $state, \%row ]);
+    }
+
+    # Place rows into the comb vector (first fit, most populated rows first)
+    my @entries;
+    my %base;
+    my $entry_cnt = 0;
+
+    foreach my $row (sort {
+        keys(%{$b->[1]}) <=> keys(%{$a->[1]}) or $a->[0]->id() cmp $b->[0]->id()
+    } @rows) {
+        my ($state, $trans) = @$row;
+
+        my @classes = sort { $a <=> $b } keys %$trans;
+
+        # No transitions, no row
+        unless (@classes) {
+            $base{$state->id()} = 0;
+
+            next;
+        }
+
+        my $base = 0;
+
+        ++$base while grep(defined $entries[$base + $_], @classes);
+
+        foreach my $class (@classes) {
+            $entries[$base + $class] = [ $state, $trans->{$class} ];
+        }
+
+        $base{$state->id()} = $base;
+
+        # Lookups of any class in the row must stay in the vector
+        $base + $class_cnt <= $entry_cnt or $entry_cnt = $base + $class_cnt;
+    }
+
+    DEBUG("Comb vector: %d classes, %d entries (%d used)",
+          $class_cnt, $entry_cnt, scalar(grep(defined, @entries)));
+
+    return {
+        class_map => \@class_map,
+        class_cnt => $class_cnt,
+        base      => \%base,
+        entries   => \@entries,
+        entry_cnt => $entry_cnt,
+    };
+}
+
+
+sub combTrans($@) {
+    my ($this, $comb) = @_;
+
+    defined $comb and $this->{_comb_trans} = $comb;
+
+    return $this->{_comb_trans};
+}
+
+
+sub _xmlComb($) {
+    my $this = shift;
+
+    my $comb = $this->comb();
+
+    my $class_map = $comb->{class_map};
+    my $entries   = $comb->{entries};
+    my $base      = $comb->{base};
+
+    my @children;
+
+    # Byte class map (as intervals of the same class, class 0 is implicit)
+    for (my $lo = 0; $lo < @$class_map; ) {
+        my $class = $class_map->[$lo];
+
+        my $hi = $lo;
+
+        ++$hi while $hi + 1 < @$class_map && $class_map->[$hi + 1] == $class;
+
+        $class and push(@children, xmlNewElement("byte-class-interval", {
+            "lo-ord" => $lo,
+            "hi-ord" => $hi,
+            "class"  => $class,
+        }));
+
+        $lo = $hi + 1;
+    }
+
+    # States rows displacements
+    foreach my $state_id (sort keys %$base) {
+        push(@children, xmlNewElement("comb-row", {
+            "state-id" => $state_id,
+            "base"     => $base->{$state_id},
+        }));
+    }
+
+    # Used entries
+    for (my $i = 0; $i < @$entries; ++$i) {
+        my $entry = $entries->[$i];
+
+        defined $entry or next;
+
+        push(@children, xmlNewElement("comb-entry", {
+            "index"     => $i,
+            "state-id"  => $entry->[0]->id(),
+            "target-id" => $entry->[1]->id(),
+        }));
+    }
+
+    return xmlNewElement("fsa-comb", {
+        "class-cnt" => $comb->{class_cnt},
+        "entry-cnt" => $comb->{entry_cnt},
+    }, @children);
+}
+
+
 sub str($) {
     my $this = shift;
 
@@ -851,7 +1043,9 @@ sub xmlChildren($) {
 
     return (
         xmlNewElement("description", {}, $this->desc()),
-        $this->_state()
+        map(xmlNewElement("skips", {}, $_), $this->skip()),
+        $this->_state(),
+        $this->combTrans() ? $this->_xmlComb() : ()
     );
 }
 
@@ -91,7 +91,7 @@ sub new($$$$$) {
     my $terminals = new CTXFryer::Table;
 
     while (my ($ident, $regex) = each %terminals) {
-        my $terminal = new CTXFryer::Grammar::Terminal($ident, $regex);
+        my $terminal = new CTXFryer::Grammar::Terminal($ident, $regex, $terminals_def->skip($ident));
 
         $terminals->at($ident, $terminal);
     }
@@ -117,6 +117,13 @@ sub new($$$$$) {
                      "isn't among non-terminals nor terminals");
         } @right;
 
+        # Skipped terminals never get to the parser
+        foreach my $symbol (@right_symbols) {
+            UNIVERSAL::isa($symbol, "CTXFryer::Grammar::Terminal") && $symbol->skip()
+            and FATAL("Rule $left => @right right side symbol %s " .
+                      "is a skipped terminal", $symbol->ident());
+        }
+
         $rules->push(new CTXFryer::Grammar::Rule($left_non_terminal => @right_symbols));
     }
 
@@ -603,8 +610,12 @@ sub reduce($) {
     }
     values %r2_rules;
 
+    # Skipped terminals are never used in rules, but the lexical
+    # analyser still needs them
+    push(@terminals, grep($_->skip(), $this->terminal()));
+
     foreach my $t (@terminals) {
-        my $t_copy = new CTXFryer::Grammar::Terminal($t->ident(), $t->regex());
+        my $t_copy = new CTXFryer::Grammar::Terminal($t->ident(), $t->regex(), $t->skip());
 
         $symbol_map{$t->id()} = $t_copy;
 
@@ -672,7 +683,7 @@ sub augmented($) {
     my $new_terminals = new CTXFryer::Table;
 
     foreach my $t ($terminals->values()) {
-        my $t_copy = new CTXFryer::Grammar::Terminal($t->ident(), $t->regex());
+        my $t_copy = new CTXFryer::Grammar::Terminal($t->ident(), $t->regex(), $t->skip());
 
         $symbol_map{$t->id()} = $t_copy;
 
@@ -8,15 +8,17 @@ use base qw(CTXFryer::Grammar::Symbol);
 use CTXFryer::Grammar::Symbol;
 
 
-sub new($$$) {
+sub new($$$@) {
     my $class = shift; $class = ref $class || $class;
 
     my $ident = shift;
     my $regex = shift;
+    my $skip  = shift || 0;
 
     my $this = $class->SUPER::new($ident);
 
     $this->{_regex} = $regex;
+    $this->{_skip}  = $skip;
 
     bless($this, $class);
 
@@ -31,6 +33,13 @@ sub regex($) {
 }
 
 
+sub skip($) {
+    my $this = shift;
+
+    return $this->{_skip};
+}
+
+
 sub xmlElementName { "terminal-symbol" }
 
 sub xmlElementAttrs($) {
@@ -40,6 +49,8 @@ sub xmlElementAttrs($) {
 
     $attrs{regex} = $this->regex();
 
+    $this->skip() and $attrs{skip} = "true";
+
     return %attrs;
 }
 
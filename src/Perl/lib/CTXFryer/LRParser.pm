@@ -287,6 +287,9 @@ sub new($$) {
         DEBUG("The parser is%s an LALR(1) parser", $this->isLALR1() ? "" : "n't");
     }
 
+    # Mark states reducing regardless of the look-ahead
+    $this->{_default_reductions} = $this->_defaultReductions();
+
     return $this;
 }
 
@@ -402,6 +405,20 @@ sub _lookbackRelation($) {
 }
 
 
+sub _defaultReductionsTable($) {
+    my $this = shift;
+
+    return $this->{_default_reductions};
+}
+
+
+sub _chainGotoTable($) {
+    my $this = shift;
+
+    return $this->{_chain_gotos};
+}
+
+
 sub _LookAheadTable($) {
     my $this = shift;
 
@@ -1030,6 +1047,150 @@ sub _invalidateNonLALR1actions($) {
 }
 
 
+sub _defaultReductions($) {
+    my $this = shift;
+
+    # A state's only valid action is reduction by a single rule
+    # ==> the reduction may be done without looking ahead
+    # (a syntax error is then detected at the next shift)
+    my %reduce_rules;
+    my %other_actions;
+
+    my $action_tab_iter = new CTXFryer::Table::Iterator($this->_actionTable());
+
+    while (my ($state, $terminal_id, $actions) = $action_tab_iter->each()) {
+        foreach my $action (grep($_->isValid(), $actions->items())) {
+            if (UNIVERSAL::isa($action, "CTXFryer::LRParser::Action::Reduce")) {
+                $reduce_rules{$state}{$action->rule()} = 1;
+            }
+            else {
+                $other_actions{$state} = 1;
+            }
+        }
+    }
+
+    my $default_reductions = new CTXFryer::Table(1);
+
+    foreach my $state (keys %reduce_rules) {
+        $other_actions{$state} and next;
+
+        my @rule_no = keys %{$reduce_rules{$state}};
+
+        1 == @rule_no or next;
+
+        DEBUG("State %d reduces by rule %d by default", $state, $rule_no[0]);
+
+        $default_reductions->at($state, $rule_no[0]);
+    }
+
+    return $default_reductions;
+}
+
+
+sub _isChainRule($$) {
+    my ($this, $rule) = @_;
+
+    # Unit rule A => B (B non-terminal)
+    1 == $rule->length() or return;
+
+    my $left  = $rule->left();
+    my $right = $rule->right(0);
+
+    UNIVERSAL::isa($right, "CTXFryer::Grammar::NonTerminal") or return;
+
+    # B node shall stand for A node, so they must have the same attributes
+    my @left_attrs  = sort map($_->identifier(), $left->attr());
+    my @right_attrs = sort map($_->identifier(), $right->attr());
+
+    "@left_attrs" eq "@right_attrs" or return;
+
+    my $rule_id = $rule->id();
+
+    # A attributes may only be copied from the same B attributes
+    foreach my $attr ($left->attr()) {
+        my @evals = grep {
+            my $eval_rule_id = $_->ruleID();
+
+            !defined $eval_rule_id || $eval_rule_id eq $rule_id
+        } $attr->evaluator();
+
+        1 == @evals or return;
+
+        my $eval = $evals[0];
+
+        UNIVERSAL::isa($eval, "CTXFryer::Grammar::Symbol::Attribute::Reference")
+        or return;
+
+        my $eval_rule_id = $eval->ruleID();
+
+        defined $eval_rule_id or return;
+
+        my $target = $eval->target();
+
+        $target->attributeIdent() eq $attr->identifier() && 1 == $target->symbolNo()
+        or return;
+    }
+
+    # B attributes may not be evaluated by the rule
+    foreach my $attr ($right->attr()) {
+        grep {
+            my $eval_rule_id = $_->ruleID();
+
+            defined $eval_rule_id && $eval_rule_id eq $rule_id
+        } $attr->evaluator()
+        and return;
+    }
+
+    return 1;
+}
+
+
+sub eliminateChainReductions($) {
+    my $this = shift;
+
+    my $grammar            = $this->grammar();
+    my $goto_tab           = $this->_gotoTable();
+    my $default_reductions = $this->_defaultReductionsTable();
+
+    # Goto (p, B) == q where q only reduces by chain rule A => B
+    # ==> the reduction may be skipped by going to (p, A), directly
+    my $chain_goto_tab = new CTXFryer::Table(2);
+
+    my $goto_tab_iter = new CTXFryer::Table::Iterator($goto_tab);
+
+    while (my ($p, $B_id, $q) = $goto_tab_iter->each()) {
+        my $target = $q;
+        my %visited;
+
+        while (defined(my $rule_no = $default_reductions->at($target))) {
+            $visited{$target}++ and last;  # sanity (cyclic chains)
+
+            my $rule = $grammar->rule($rule_no);
+
+            $this->_isChainRule($rule) or last;
+
+            my $next = $goto_tab->at($p, $rule->left()->id());
+
+            defined $next or last;
+
+            DEBUX(1, "Chain reduction by rule %d skipped: goto(%d, %s) == %d",
+                     $rule_no, $p, $B_id, $next);
+
+            $target = $next;
+        }
+
+        $target == $q and next;
+
+        DEBUG("Chain reductions skipped: goto(%d, %s) == %d instead of %d",
+              $p, $B_id, $target, $q);
+
+        $chain_goto_tab->at($p, $B_id, $target);
+    }
+
+    $this->{_chain_gotos} = $chain_goto_tab;
+}
+
+
 sub _makeLALR1($) {
     my $this = shift;
 
@@ -1233,6 +1394,12 @@ sub xmlChildren($) {
         $this->_gotoTable()
     );
 
+    my $default_reductions_child = xmlNewElement(
+        "default-reductions",
+        {},
+        $this->_defaultReductionsTable()
+    );
+
     my @children = (
         $this->grammar(),
 #        $sym_tab_child,
@@ -1240,6 +1407,7 @@ sub xmlChildren($) {
         $trans_tab_child,
         $action_tab_child,
         $goto_tab_child,
+        $default_reductions_child,
     );
 
     my $sr = $this->_shiftReduceConflicts();
@@ -1260,6 +1428,15 @@ sub xmlChildren($) {
         $rr
     ));
 
+    my $chain_goto_tab = $this->_chainGotoTable();
+
+    defined $chain_goto_tab
+    and push(@children, xmlNewElement(
+        "chain-goto-table",
+        {},
+        $chain_goto_tab
+    ));
+
     my $DR = $this->_DirectReadFunction();
 
     defined $DR
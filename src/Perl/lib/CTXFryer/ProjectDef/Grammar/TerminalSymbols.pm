@@ -11,7 +11,10 @@ use CTXFryer::Logging qw(:all);
 sub new($) {
     my $class = shift; $class = ref $class || $class;
 
-    my $this = {};
+    my $this = {
+        _regex => {},
+        _skip  => {},
+    };
 
     return bless($this, $class);
 }
@@ -20,28 +23,35 @@ sub new($) {
 sub identifers($) {
     my $this = shift;
 
-    return keys %$this;
+    return keys %{$this->{_regex}};
 }
 
 
 sub map($) {
     my $this = shift;
 
-    return %$this;
+    return %{$this->{_regex}};
 }
 
 
 sub regex($$) {
     my ($this, $ident) = @_;
 
-    return $this->{$ident};
+    return $this->{_regex}->{$ident};
+}
+
+
+sub skip($$) {
+    my ($this, $ident) = @_;
+
+    return $this->{_skip}->{$ident};
 }
 
 
 sub exists($$) {
     my ($this, $ident) = @_;
 
-    exists $this->{$ident};
+    exists $this->{_regex}->{$ident};
 }
 
 
@@ -50,15 +60,17 @@ sub parse($$$) {
 
     my $ret = 0;
 
-    # Terminal definition
-    if ($line =~ /^\s*([A-Za-z_]\w*)\s*=\s*(\/.*\/[a-z]*)\s*$/) {
+    # Terminal definition (optionally skipped, i.e. ignored by parser)
+    if ($line =~ /^\s*([A-Za-z_]\w*)\s*=\s*(\/.*\/[a-z]*)(\s+(?i:Skip))?\s*$/) {
         my $ident = $1;
         my $regex = $2;
+        my $skip  = $3 ? 1 : 0;
 
-        exists $this->{$ident} &&
+        exists $this->{_regex}->{$ident} &&
         WARN("Terminal symbol %s redefinition at %s", $ident, $pos);
 
-        $this->{$ident} = $regex;
+        $this->{_regex}->{$ident} = $regex;
+        $this->{_skip}->{$ident}  = $skip;
     }
 
     # Parse error
@@ -83,10 +83,19 @@ rm   = rm -f
 # Add --log-position for logging message position in the code
 log_options = --log-level INFO
 
+# Add --eliminate-chain-rules for skipping chain rules reductions
+# (note that such reductions are then missing in derivations
+# and no reduce callbacks nor reduce events happen for them)
+parser_options =
+
+# Add --comb for comb-vector FSA transitions
+# (required by C target configured --with-fsa-tables=comb)
+fsa_options =
+
 grammar2regex    = ctx-fryer-cfg2re
 grammar2tlang    = ctx-fryer-cfg2tlang
-regex2fsa        = ctx-fryer-re2fsa \$(log_options)
-grammar2lrparser = ctx-fryer-cfg2parser \$(log_options)
+regex2fsa        = ctx-fryer-re2fsa \$(log_options) \$(fsa_options)
+grammar2lrparser = ctx-fryer-cfg2parser \$(log_options) \$(parser_options)
 
 
 .PHONY: all doc $tlangs